@@ -0,0 +1,67 @@
+#include "ofMain.h"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times the shared float formatter against the ostringstream formatting that
+// the writers used before it, on one million random doubles: fixed notation
+// at precision 6 and the shortest round-trip form. Exits with 1 if the fixed
+// output differs from the ostringstream output.
+
+using namespace ofx::configbridge;
+
+namespace {
+// the former per-writer formatting: std::fixed, then trailing zeros stripped
+std::string streamFormat(double value, int precision){
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(precision) << value;
+	std::string result = ss.str();
+	if (result.find('.') != std::string::npos) {
+		while (result.length() > 2 && result.back() == '0') result.pop_back();
+		if (result.back() == '.') result += '0';
+	}
+	return result;
+}
+
+template<class Run>
+double millis(Run run){
+	auto start = std::chrono::steady_clock::now();
+	run();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+//========================================================================
+int main(){
+	std::mt19937_64 rng(1);
+	std::uniform_real_distribution<double> dist(-1000, 1000);
+	std::vector<double> values(1000000);
+	for (auto& v : values) v = dist(rng);
+
+	int mismatches = 0;
+	for (double v : values) {
+		if (streamFormat(v, 6) != formatFloat(v, 6) && mismatches++ < 5)
+			ofLogError("float") << streamFormat(v, 6) << " != " << formatFloat(v, 6);
+	}
+
+	std::size_t chars = 0; // keeps the loops from being optimized away
+	std::string out;
+	const double stream = millis([&]{ for (double v : values) chars += streamFormat(v, 6).size(); });
+	const double fixed = millis([&]{
+		for (double v : values) { out.clear(); appendFloat(out, v, 6); chars += out.size(); }
+	});
+	const double shortest = millis([&]{
+		for (double v : values) { out.clear(); appendFloat(out, v, -1); chars += out.size(); }
+	});
+
+	ofLogNotice("float") << values.size() << " values, " << chars << " chars";
+	ofLogNotice("float") << "ostringstream, precision 6: " << stream << " ms";
+	ofLogNotice("float") << "formatFloat, precision 6:   " << fixed << " ms (" << stream / fixed << "x)";
+	ofLogNotice("float") << "formatFloat, shortest:      " << shortest << " ms (" << stream / shortest << "x)";
+	if (mismatches) ofLogError("float") << mismatches << " values differ from ostringstream";
+	return mismatches ? 1 : 0;
+}
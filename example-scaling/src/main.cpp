@@ -0,0 +1,91 @@
+#include "ofMain.h"
+#include "ofxConfigBridgeAPI.hpp"
+#include "ofxConfigBridgeObjectBuilder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+// Checks that TOML <-> JSON/YAML conversion time grows linearly with the
+// number of nodes, for both deeply nested and wide documents. Each input is
+// converted at 1x, 2x, 4x and 8x its base size; a conversion that copied
+// subtrees at every level would take about 8 times as long per node at the
+// largest size. Exits with 1 if any conversion grows by more than 3 times.
+
+using namespace ofx::configbridge;
+
+namespace {
+// a chain of `depth` tables, each with one nested table and one float
+toml::ordered_value deepToml(int depth){
+	toml::ordered_value v = toml::ordered_table{};
+	v.as_table()["leaf"] = 1;
+	for (int i = 0; i < depth; ++i) {
+		// a growing toml table would copy the chain, as toml values have no noexcept move
+		TomlTableBuilder<toml::ordered_value> t(2);
+		t.add("k", std::move(v));
+		t.add("x", 1.5);
+		v = t.finish();
+	}
+	return v;
+}
+
+// one table with `width` sub-tables of two values each
+toml::ordered_value wideToml(int width){
+	TomlTableBuilder<toml::ordered_value> t(width);
+	for (int i = 0; i < width; ++i) {
+		TomlTableBuilder<toml::ordered_value> item(2);
+		item.add("id", i);
+		item.add("values", toml::ordered_array{1.5, 2.5, 3.5});
+		t.add("item" + std::to_string(i), item.finish());
+	}
+	return t.finish();
+}
+
+// best of several runs, in nanoseconds per node
+template<class Run>
+double nanosPerNode(Run run, int nodes){
+	using clock = std::chrono::steady_clock;
+	double best = 0;
+	for (int i = 0; i < 5; ++i) {
+		auto start = clock::now();
+		run();
+		double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+		if (i == 0 || ns < best) best = ns;
+	}
+	return best / nodes;
+}
+
+template<class Make, class Convert>
+bool checkLinear(const std::string& name, int base, Make make, Convert convert){
+	double first = 0, worst = 0;
+	for (int scale : {1, 2, 4, 8}) {
+		const int size = base * scale;
+		const auto input = make(size);
+		const double ns = nanosPerNode([&]{ convert(input); }, size);
+		ofLogNotice("scaling") << name << " size " << size << ": " << ns << " ns per node";
+		if (scale == 1) first = ns;
+		else            worst = std::max(worst, ns);
+	}
+	const bool ok = worst <= first * 3;
+	if (!ok) ofLogError("scaling") << name << " grows faster than linearly";
+	return ok;
+}
+}
+
+//========================================================================
+int main(){
+	using Make = toml::ordered_value(*)(int);
+	const std::pair<std::string, Make> shapes[] = {{"deep", deepToml}, {"wide", wideToml}};
+	bool ok = true;
+	for (const auto& [shape, make] : shapes) {
+		const int base = make == deepToml ? 500 : 4000;
+		auto toJson = [make = make](int n){ return convert<nlohmann::ordered_json>(make(n)); };
+		auto toYaml = [make = make](int n){ return convert<YAML::Node>(make(n)); };
+		ok &= checkLinear(shape + " toml->json", base, make, [](const toml::ordered_value& t){ convert<nlohmann::ordered_json>(t); });
+		ok &= checkLinear(shape + " toml->yaml", base, make, [](const toml::ordered_value& t){ convert<YAML::Node>(t); });
+		ok &= checkLinear(shape + " json->toml", base, toJson, [](const nlohmann::ordered_json& j){ convert<toml::ordered_value>(j); });
+		ok &= checkLinear(shape + " yaml->toml", base, toYaml, [](const YAML::Node& y){ convert<toml::ordered_value>(y); });
+	}
+	ofLogNotice("scaling") << (ok ? "all conversions scale linearly" : "FAILED");
+	return ok ? 0 : 1;
+}
@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -59,6 +60,12 @@ class YAML_CPP_API Emitter {
   bool SetPostCommentIndent(std::size_t n);
   bool SetFloatPrecision(std::size_t n);
   bool SetDoublePrecision(std::size_t n);
+  // Called for each untagged string scalar written with the Auto string
+  // format (e.g. a Node scalar that was plain in its source), except map
+  // keys. Returning true writes `out` in place of `str`.
+  using ScalarFormatter =
+      std::function<bool(const std::string& str, std::string& out)>;
+  void SetScalarFormatter(ScalarFormatter formatter);
   void RestoreGlobalModifiedSettings();
 
   // local setters
@@ -131,6 +138,7 @@ class YAML_CPP_API Emitter {
  private:
   std::unique_ptr<EmitterState> m_pState;
   ostream_wrapper m_stream;
+  ScalarFormatter m_scalarFormatter;
 };
 
 template <typename T>
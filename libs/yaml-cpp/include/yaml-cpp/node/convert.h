@@ -8,13 +8,9 @@
 #endif
 
 #include <array>
-#include <cmath>
-#include <limits>
 #include <list>
 #include <map>
 #include <unordered_map>
-#include <sstream>
-#include <type_traits>
 #include <valarray>
 #include <vector>
 
@@ -116,126 +112,35 @@ struct convert<_Null> {
   }
 };
 
-namespace conversion {
-template <typename T>
-typename std::enable_if< std::is_floating_point<T>::value, void>::type
-inner_encode(const T& rhs, std::stringstream& stream){
-  if (std::isnan(rhs)) {
-    stream << ".nan";
-  } else if (std::isinf(rhs)) {
-    if (std::signbit(rhs)) {
-      stream << "-.inf";
-    } else {
-      stream << ".inf";
-    }
-  } else {
-    stream << rhs;
-  }
-}
-
-template <typename T>
-typename std::enable_if<!std::is_floating_point<T>::value, void>::type
-inner_encode(const T& rhs, std::stringstream& stream){
-  stream << rhs;
-}
-
-template <typename T>
-typename std::enable_if<(std::is_same<T, unsigned char>::value ||
-                         std::is_same<T, signed char>::value), bool>::type
-ConvertStreamTo(std::stringstream& stream, T& rhs) {
-  int num;
-  if ((stream >> std::noskipws >> num) && (stream >> std::ws).eof()) {
-    if (num >= (std::numeric_limits<T>::min)() &&
-        num <= (std::numeric_limits<T>::max)()) {
-      rhs = static_cast<T>(num);
-      return true;
-    }
+// Numbers are read with the syntax of operator>> on a stream whose basefield
+// is cleared (0x for hex, a leading 0 for octal), trailing whitespace allowed,
+// plus YAML's .inf and .nan for floating point. The character types are
+// written as a single character; only char is also read as one.
+#define YAML_DEFINE_CONVERT_ARITHMETIC(type)                      \
+  template <>                                                     \
+  struct convert<type> {                                          \
+    YAML_CPP_API static Node encode(const type& rhs);             \
+    YAML_CPP_API static bool decode(const Node& node, type& rhs); \
   }
-  return false;
-}
-
-template <typename T>
-typename std::enable_if<!(std::is_same<T, unsigned char>::value ||
-                          std::is_same<T, signed char>::value), bool>::type
-ConvertStreamTo(std::stringstream& stream, T& rhs) {
-  if ((stream >> std::noskipws >> rhs) && (stream >> std::ws).eof()) {
-    return true;
-  }
-  return false;
-}
-}
-
-#define YAML_DEFINE_CONVERT_STREAMABLE(type, negative_op)                  \
-  template <>                                                              \
-  struct convert<type> {                                                   \
-                                                                           \
-    static Node encode(const type& rhs) {                                  \
-      std::stringstream stream;                                            \
-      stream.precision(std::numeric_limits<type>::max_digits10);           \
-      conversion::inner_encode(rhs, stream);                               \
-      return Node(stream.str());                                           \
-    }                                                                      \
-                                                                           \
-    static bool decode(const Node& node, type& rhs) {                      \
-      if (node.Type() != NodeType::Scalar) {                               \
-        return false;                                                      \
-      }                                                                    \
-      const std::string& input = node.Scalar();                            \
-      std::stringstream stream(input);                                     \
-      stream.unsetf(std::ios::dec);                                        \
-      if ((stream.peek() == '-') && std::is_unsigned<type>::value) {       \
-        return false;                                                      \
-      }                                                                    \
-      if (conversion::ConvertStreamTo(stream, rhs)) {                      \
-        return true;                                                       \
-      }                                                                    \
-      if (std::numeric_limits<type>::has_infinity) {                       \
-        if (conversion::IsInfinity(input)) {                               \
-          rhs = std::numeric_limits<type>::infinity();                     \
-          return true;                                                     \
-        } else if (conversion::IsNegativeInfinity(input)) {                \
-          rhs = negative_op std::numeric_limits<type>::infinity();         \
-          return true;                                                     \
-        }                                                                  \
-      }                                                                    \
-                                                                           \
-      if (std::numeric_limits<type>::has_quiet_NaN) {                      \
-        if (conversion::IsNaN(input)) {                                    \
-          rhs = std::numeric_limits<type>::quiet_NaN();                    \
-          return true;                                                     \
-        }                                                                  \
-      }                                                                    \
-                                                                           \
-      return false;                                                        \
-    }                                                                      \
-  }
-
-#define YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(type) \
-  YAML_DEFINE_CONVERT_STREAMABLE(type, -)
-
-#define YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(type) \
-  YAML_DEFINE_CONVERT_STREAMABLE(type, +)
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(int);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(short);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long long);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned short);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned long);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned long long);
+YAML_DEFINE_CONVERT_ARITHMETIC(int);
+YAML_DEFINE_CONVERT_ARITHMETIC(short);
+YAML_DEFINE_CONVERT_ARITHMETIC(long);
+YAML_DEFINE_CONVERT_ARITHMETIC(long long);
+YAML_DEFINE_CONVERT_ARITHMETIC(unsigned);
+YAML_DEFINE_CONVERT_ARITHMETIC(unsigned short);
+YAML_DEFINE_CONVERT_ARITHMETIC(unsigned long);
+YAML_DEFINE_CONVERT_ARITHMETIC(unsigned long long);
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(char);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(signed char);
-YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED(unsigned char);
+YAML_DEFINE_CONVERT_ARITHMETIC(char);
+YAML_DEFINE_CONVERT_ARITHMETIC(signed char);
+YAML_DEFINE_CONVERT_ARITHMETIC(unsigned char);
 
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(float);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(double);
-YAML_DEFINE_CONVERT_STREAMABLE_SIGNED(long double);
+YAML_DEFINE_CONVERT_ARITHMETIC(float);
+YAML_DEFINE_CONVERT_ARITHMETIC(double);
+YAML_DEFINE_CONVERT_ARITHMETIC(long double);
 
-#undef YAML_DEFINE_CONVERT_STREAMABLE_SIGNED
-#undef YAML_DEFINE_CONVERT_STREAMABLE_UNSIGNED
-#undef YAML_DEFINE_CONVERT_STREAMABLE
+#undef YAML_DEFINE_CONVERT_ARITHMETIC
 
 // bool
 template <>
@@ -7,6 +7,8 @@
 #pragma once
 #endif
 
+#include <cstddef>
+#include <memory>
 #include <set>
 
 #include "yaml-cpp/dll.h"
@@ -20,15 +22,23 @@ class node;
 
 namespace YAML {
 namespace detail {
+// Nodes are allocated together with their node_ref and node_data in blocks
+// that grow geometrically, and are destroyed with the block. Merging shares
+// ownership of the other memory's blocks rather than of each of its nodes.
 class YAML_CPP_API memory {
  public:
-  memory() : m_nodes{} {}
+  memory() : m_blocks{}, m_pCurrent(nullptr) {}
+  memory(const memory&) = delete;
+  memory& operator=(const memory&) = delete;
+
   node& create_node();
   void merge(const memory& rhs);
 
  private:
-  using Nodes = std::set<shared_node>;
-  Nodes m_nodes;
+  class block;
+  using Blocks = std::set<std::shared_ptr<block>>;
+  Blocks m_blocks;
+  block* m_pCurrent;
 };
 
 class YAML_CPP_API memory_holder {
@@ -24,12 +24,12 @@ class node {
   };
 
  public:
-  node() : m_pRef(new node_ref), m_dependencies{}, m_index{} {}
+  explicit node(node_ref& ref) : m_pRef(&ref), m_dependencies{}, m_index{} {}
   node(const node&) = delete;
   node& operator=(const node&) = delete;
 
   bool is(const node& rhs) const { return m_pRef == rhs.m_pRef; }
-  const node_ref* ref() const { return m_pRef.get(); }
+  const node_ref* ref() const { return m_pRef; }
 
   bool is_defined() const { return m_pRef->is_defined(); }
   const Mark& mark() const { return m_pRef->mark(); }
@@ -121,6 +121,7 @@ class node {
     key.add_dependency(*this);
     value.add_dependency(*this);
   }
+  void reserve(std::size_t n) { m_pRef->reserve(n); }
 
   // indexing
   template <typename Key>
@@ -165,7 +166,7 @@ class node {
   }
 
  private:
-  shared_node_ref m_pRef;
+  node_ref* m_pRef;  // owned by the memory that created it
   using nodes = std::set<node*, less>;
   nodes m_dependencies;
   size_t m_index;
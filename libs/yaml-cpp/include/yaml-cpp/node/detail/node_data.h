@@ -62,6 +62,7 @@ class YAML_CPP_API node_data {
   // sequence
   void push_back(node& node, const shared_memory_holder& pMemory);
   void insert(node& key, node& value, const shared_memory_holder& pMemory);
+  void reserve(std::size_t n);
 
   // indexing
   template <typename Key>
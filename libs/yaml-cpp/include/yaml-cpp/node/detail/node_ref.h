@@ -16,7 +16,7 @@ namespace YAML {
 namespace detail {
 class node_ref {
  public:
-  node_ref() : m_pData(new node_data) {}
+  explicit node_ref(node_data& data) : m_pData(&data) {}
   node_ref(const node_ref&) = delete;
   node_ref& operator=(const node_ref&) = delete;
 
@@ -57,6 +57,7 @@ class node_ref {
   void insert(node& key, node& value, shared_memory_holder pMemory) {
     m_pData->insert(key, value, pMemory);
   }
+  void reserve(std::size_t n) { m_pData->reserve(n); }
 
   // indexing
   template <typename Key>
@@ -90,7 +91,7 @@ class node_ref {
   }
 
  private:
-  shared_node_data m_pData;
+  node_data* m_pData;  // owned by the memory that created it
 };
 }
 }
@@ -0,0 +1,46 @@
+#ifndef NODE_FACTORY_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define NODE_FACTORY_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <string>
+
+#include "yaml-cpp/dll.h"
+#include "yaml-cpp/emitterstyle.h"
+#include "yaml-cpp/node/node.h"
+#include "yaml-cpp/node/ptr.h"
+
+namespace YAML {
+// Builds a tree whose nodes all share one memory holder, so attaching a
+// child never merges node sets. Append() does not look for an existing key:
+// the caller guarantees that keys are unique, as when converting from a
+// format that already enforces it.
+class YAML_CPP_API NodeFactory {
+ public:
+  NodeFactory();
+  NodeFactory(const NodeFactory&) = delete;
+  NodeFactory& operator=(const NodeFactory&) = delete;
+
+  Node Null();
+  Node Scalar(const std::string& value);
+  Node Sequence(std::size_t reserve = 0,
+                EmitterStyle::value style = EmitterStyle::Default);
+  Node Map(std::size_t reserve = 0,
+           EmitterStyle::value style = EmitterStyle::Default);
+
+  void Append(Node& sequence, const Node& value);
+  void Append(Node& map, const Node& key, const Node& value);
+
+ private:
+  Node Adopt(const Node& node);
+
+  detail::shared_memory_holder m_pMemory;
+};
+}  // namespace YAML
+
+#endif  // NODE_FACTORY_H_62B23520_7C8E_11DE_8A39_0800200C9A66
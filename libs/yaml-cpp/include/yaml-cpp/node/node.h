@@ -30,6 +30,7 @@ class YAML_CPP_API Node {
  public:
   friend class NodeBuilder;
   friend class NodeEvents;
+  friend class NodeFactory;
   friend struct detail::iterator_value;
   friend class detail::node;
   friend class detail::node_data;
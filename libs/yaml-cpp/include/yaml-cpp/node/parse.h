@@ -7,6 +7,7 @@
 #pragma once
 #endif
 
+#include <cstddef>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -30,6 +31,13 @@ YAML_CPP_API Node Load(const std::string& input);
  */
 YAML_CPP_API Node Load(const char* input);
 
+/**
+ * Loads size bytes at input as a single YAML document, without copying them.
+ *
+ * @throws {@link ParserException} if it is malformed.
+ */
+YAML_CPP_API Node Load(const char* input, std::size_t size);
+
 /**
  * Loads the input stream as a single YAML document.
  *
@@ -59,6 +67,14 @@ YAML_CPP_API std::vector<Node> LoadAll(const std::string& input);
  */
 YAML_CPP_API std::vector<Node> LoadAll(const char* input);
 
+/**
+ * Loads size bytes at input as a list of YAML documents, without copying
+ * them.
+ *
+ * @throws {@link ParserException} if it is malformed.
+ */
+YAML_CPP_API std::vector<Node> LoadAll(const char* input, std::size_t size);
+
 /**
  * Loads the input stream as a list of YAML documents.
  *
@@ -0,0 +1,126 @@
+#include "bytescan.h"
+
+#if defined(__AVX2__)
+#define YAML_CPP_BYTESCAN_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YAML_CPP_BYTESCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace YAML {
+namespace {
+#if defined(YAML_CPP_BYTESCAN_AVX2) || defined(YAML_CPP_BYTESCAN_SSE2)
+// index of the lowest set bit; mask is never zero
+inline std::size_t LowestBit(unsigned mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+#if defined(YAML_CPP_BYTESCAN_AVX2)
+using Chunk = __m256i;
+const std::size_t kChunkSize = 32;
+inline Chunk Load(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+inline Chunk Splat(char ch) { return _mm256_set1_epi8(ch); }
+inline Chunk Equal(Chunk a, Chunk b) { return _mm256_cmpeq_epi8(a, b); }
+inline Chunk Less(Chunk a, Chunk b) { return _mm256_cmpgt_epi8(b, a); }
+inline Chunk Or(Chunk a, Chunk b) { return _mm256_or_si256(a, b); }
+inline unsigned Mask(Chunk a) {
+  return static_cast<unsigned>(_mm256_movemask_epi8(a));
+}
+const unsigned kFullMask = 0xffffffffu;
+#elif defined(YAML_CPP_BYTESCAN_SSE2)
+using Chunk = __m128i;
+const std::size_t kChunkSize = 16;
+inline Chunk Load(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline Chunk Splat(char ch) { return _mm_set1_epi8(ch); }
+inline Chunk Equal(Chunk a, Chunk b) { return _mm_cmpeq_epi8(a, b); }
+inline Chunk Less(Chunk a, Chunk b) { return _mm_cmplt_epi8(a, b); }
+inline Chunk Or(Chunk a, Chunk b) { return _mm_or_si128(a, b); }
+inline unsigned Mask(Chunk a) {
+  return static_cast<unsigned>(_mm_movemask_epi8(a));
+}
+const unsigned kFullMask = 0xffffu;
+#endif
+
+inline bool IsPrintableAscii(char ch) { return 0x20 <= ch && ch < 0x7F; }
+}  // namespace
+
+std::size_t SkipByte(const char* first, const char* last, char ch) {
+  const char* p = first;
+#if defined(YAML_CPP_BYTESCAN_AVX2) || defined(YAML_CPP_BYTESCAN_SSE2)
+  const Chunk needle = Splat(ch);
+  for (; static_cast<std::size_t>(last - p) >= kChunkSize; p += kChunkSize) {
+    unsigned mask = Mask(Equal(Load(p), needle)) ^ kFullMask;
+    if (mask)
+      return static_cast<std::size_t>(p - first) + LowestBit(mask);
+  }
+#endif
+  while (p != last && *p == ch)
+    ++p;
+  return static_cast<std::size_t>(p - first);
+}
+
+std::size_t FindByte(const char* first, const char* last, const ByteSet& set) {
+  const char* p = first;
+#if defined(YAML_CPP_BYTESCAN_AVX2) || defined(YAML_CPP_BYTESCAN_SSE2)
+  if (set.size() > 0) {
+    Chunk needles[ByteSet::kMaxSize];
+    for (std::size_t i = 0; i < set.size(); i++)
+      needles[i] = Splat(set[i]);
+    for (; static_cast<std::size_t>(last - p) >= kChunkSize; p += kChunkSize) {
+      const Chunk chunk = Load(p);
+      Chunk hits = Equal(chunk, needles[0]);
+      for (std::size_t i = 1; i < set.size(); i++)
+        hits = Or(hits, Equal(chunk, needles[i]));
+      unsigned mask = Mask(hits);
+      if (mask)
+        return static_cast<std::size_t>(p - first) + LowestBit(mask);
+    }
+  }
+#endif
+  while (p != last && !set.Contains(*p))
+    ++p;
+  return static_cast<std::size_t>(p - first);
+}
+
+std::size_t FindByteOrNonPrintable(const char* first, const char* last,
+                                   const ByteSet& set) {
+  const char* p = first;
+#if defined(YAML_CPP_BYTESCAN_AVX2) || defined(YAML_CPP_BYTESCAN_SSE2)
+  // as signed bytes, everything outside printable ASCII is below ' ' or DEL
+  const Chunk space = Splat(' ');
+  const Chunk del = Splat('\x7F');
+  Chunk needles[ByteSet::kMaxSize];
+  for (std::size_t i = 0; i < set.size(); i++)
+    needles[i] = Splat(set[i]);
+  for (; static_cast<std::size_t>(last - p) >= kChunkSize; p += kChunkSize) {
+    const Chunk chunk = Load(p);
+    Chunk hits = Or(Less(chunk, space), Equal(chunk, del));
+    for (std::size_t i = 0; i < set.size(); i++)
+      hits = Or(hits, Equal(chunk, needles[i]));
+    unsigned mask = Mask(hits);
+    if (mask)
+      return static_cast<std::size_t>(p - first) + LowestBit(mask);
+  }
+#endif
+  while (p != last && IsPrintableAscii(*p) && !set.Contains(*p))
+    ++p;
+  return static_cast<std::size_t>(p - first);
+}
+}  // namespace YAML
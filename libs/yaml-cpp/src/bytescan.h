@@ -0,0 +1,63 @@
+#ifndef BYTESCAN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define BYTESCAN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+
+namespace YAML {
+// A small set of bytes to search for; see FindByte.
+class ByteSet {
+ public:
+  static const std::size_t kMaxSize = 16;
+
+  ByteSet() : m_bytes{}, m_size(0), m_member{} {}
+  explicit ByteSet(const char* bytes) : ByteSet() {
+    while (*bytes)
+      Add(*bytes++);
+  }
+
+  // Returns false if the set is already full.
+  bool Add(char ch) {
+    if (Contains(ch))
+      return true;
+    if (m_size == kMaxSize)
+      return false;
+    m_bytes[m_size++] = ch;
+    m_member[static_cast<unsigned char>(ch)] = true;
+    return true;
+  }
+
+  bool Contains(char ch) const {
+    return m_member[static_cast<unsigned char>(ch)];
+  }
+  std::size_t size() const { return m_size; }
+  char operator[](std::size_t i) const { return m_bytes[i]; }
+
+ private:
+  char m_bytes[kMaxSize];
+  std::size_t m_size;
+  bool m_member[256];
+};
+
+// Searches over contiguous input, vectorised with AVX2 or SSE2 when the build
+// targets them. Both return an offset from first, or last - first if the
+// search runs off the end.
+
+// offset of the first byte that is not ch
+std::size_t SkipByte(const char* first, const char* last, char ch);
+
+// offset of the first byte in set
+std::size_t FindByte(const char* first, const char* last, const ByteSet& set);
+
+// offset of the first byte in set or outside printable ASCII, i.e. a control
+// character, DEL or part of a multi-byte UTF-8 sequence
+std::size_t FindByteOrNonPrintable(const char* first, const char* last,
+                                   const ByteSet& set);
+}  // namespace YAML
+
+#endif  // BYTESCAN_H_62B23520_7C8E_11DE_8A39_0800200C9A66
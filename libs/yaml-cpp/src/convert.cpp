@@ -1,4 +1,10 @@
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <type_traits>
 
 #include "yaml-cpp/node/convert.h"
 
@@ -35,6 +41,169 @@ bool IsFlexibleCase(const std::string& str) {
   std::string rest = str.substr(1);
   return firstcaps && (IsEntirely(rest, IsLower) || IsEntirely(rest, IsUpper));
 }
+
+// what std::ws skips in the classic locale
+bool IsTrailingSpace(const char* first, const char* last) {
+  return std::all_of(first, last, [](char ch) {
+    return ch == ' ' || ('\t' <= ch && ch <= '\r');
+  });
+}
+
+template <typename T>
+bool DecodeStream(const std::string& input, T& rhs) {
+  std::stringstream stream(input);
+  stream.unsetf(std::ios::dec);
+  return (stream >> std::noskipws >> rhs) && (stream >> std::ws).eof();
+}
+
+template <typename T>
+bool DecodeInteger(const std::string& input, T& rhs) {
+  using U = typename std::make_unsigned<T>::type;
+
+  const char* p = input.data();
+  const char* const last = p + input.size();
+  bool negative = false;
+  if (p != last && (*p == '+' || *p == '-')) {
+    negative = *p++ == '-';
+    if (negative && std::is_unsigned<T>::value)
+      return false;
+  }
+
+  // the base detection of operator>> with the basefield cleared
+  int base = 10;
+  if (p != last && *p == '0') {
+    if (last - p > 1 && (p[1] == 'x' || p[1] == 'X')) {
+      base = 16;
+      p += 2;
+    } else {
+      base = 8;
+    }
+  }
+
+  // read the magnitude so that prefixes can follow the sign
+  U magnitude = 0;
+  std::from_chars_result result = std::from_chars(p, last, magnitude, base);
+  if (result.ec != std::errc() || !IsTrailingSpace(result.ptr, last))
+    return false;
+  U limit = static_cast<U>((std::numeric_limits<T>::max)());
+  if (negative)
+    ++limit;
+  if (magnitude > limit)
+    return false;
+
+  rhs = static_cast<T>(negative ? U(0) - magnitude : magnitude);
+  return true;
+}
+
+// Floating-point from_chars and to_chars are missing from some standard
+// libraries (e.g. Apple's libc++ before macOS 13.3), which keep the stream
+// conversions.
+#if defined(__cpp_lib_to_chars)
+template <typename T>
+bool DecodeNumber(const std::string& input, T& rhs) {
+  const char* first = input.data();
+  const char* const last = first + input.size();
+
+  // from_chars takes no '+', and reads "inf" and "nan", which operator>> and
+  // YAML don't
+  const char* p = first;
+  if (p != last && *p == '+')
+    first = ++p;
+  else if (p != last && *p == '-')
+    ++p;
+  if (p == last || !(('0' <= *p && *p <= '9') || *p == '.'))
+    return false;
+
+  T value;
+  std::from_chars_result result = std::from_chars(first, last, value);
+  if (result.ec == std::errc::result_out_of_range)
+    return DecodeStream(input, rhs);  // keep the stream's view of underflow
+  if (result.ec != std::errc() || !IsTrailingSpace(result.ptr, last))
+    return false;
+  rhs = value;
+  return true;
+}
+
+// long double is not universally supported by std::from_chars
+bool DecodeNumber(const std::string& input, long double& rhs) {
+  return DecodeStream(input, rhs);
+}
+#else
+template <typename T>
+bool DecodeNumber(const std::string& input, T& rhs) {
+  return DecodeStream(input, rhs);
+}
+#endif
+
+template <typename T>
+bool DecodeFloat(const std::string& input, T& rhs) {
+  if (DecodeNumber(input, rhs))
+    return true;
+  if (YAML::conversion::IsInfinity(input)) {
+    rhs = std::numeric_limits<T>::infinity();
+    return true;
+  }
+  if (YAML::conversion::IsNegativeInfinity(input)) {
+    rhs = -std::numeric_limits<T>::infinity();
+    return true;
+  }
+  if (YAML::conversion::IsNaN(input)) {
+    rhs = std::numeric_limits<T>::quiet_NaN();
+    return true;
+  }
+  return false;
+}
+
+bool DecodeCharacter(const std::string& input, char& rhs) {
+  if (input.empty() || !IsTrailingSpace(input.data() + 1,
+                                        input.data() + input.size()))
+    return false;
+  if (std::is_unsigned<char>::value && input[0] == '-')
+    return false;
+  rhs = input[0];
+  return true;
+}
+
+template <typename T>
+YAML::Node EncodeInteger(T rhs) {
+  char buffer[std::numeric_limits<T>::digits10 + 3];
+  return YAML::Node(
+      std::string(buffer, std::to_chars(buffer, std::end(buffer), rhs).ptr));
+}
+
+template <typename T>
+YAML::Node EncodeFloatStream(T rhs) {
+  std::stringstream stream;
+  stream.precision(std::numeric_limits<T>::max_digits10);
+  stream << rhs;
+  return YAML::Node(stream.str());
+}
+
+template <typename T>
+YAML::Node EncodeFloat(T rhs) {
+  if (std::isnan(rhs))
+    return YAML::Node(".nan");
+  if (std::isinf(rhs))
+    return YAML::Node(std::signbit(rhs) ? "-.inf" : ".inf");
+
+#if defined(__cpp_lib_to_chars)
+  // what operator<< writes at max_digits10, i.e. printf's %.17g for double
+  char buffer[64];
+  return YAML::Node(std::string(
+      buffer, std::to_chars(buffer, std::end(buffer), rhs,
+                            std::chars_format::general,
+                            std::numeric_limits<T>::max_digits10)
+                  .ptr));
+#else
+  return EncodeFloatStream(rhs);
+#endif
+}
+
+YAML::Node EncodeFloat(long double rhs) {
+  if (std::isnan(rhs) || std::isinf(rhs))
+    return EncodeFloat(static_cast<double>(rhs));
+  return EncodeFloatStream(rhs);
+}
 }  // namespace
 
 namespace YAML {
@@ -71,4 +240,62 @@ bool convert<bool>::decode(const Node& node, bool& rhs) {
 
   return false;
 }
+
+#define YAML_DEFINE_CONVERT_INTEGER(type)                        \
+  Node convert<type>::encode(const type& rhs) {                  \
+    return EncodeInteger(rhs);                                   \
+  }                                                              \
+  bool convert<type>::decode(const Node& node, type& rhs) {      \
+    return node.IsScalar() && DecodeInteger(node.Scalar(), rhs); \
+  }
+
+#define YAML_DEFINE_CONVERT_FLOAT(type)                        \
+  Node convert<type>::encode(const type& rhs) {                \
+    return EncodeFloat(rhs);                                   \
+  }                                                            \
+  bool convert<type>::decode(const Node& node, type& rhs) {    \
+    return node.IsScalar() && DecodeFloat(node.Scalar(), rhs); \
+  }
+
+YAML_DEFINE_CONVERT_INTEGER(int)
+YAML_DEFINE_CONVERT_INTEGER(short)
+YAML_DEFINE_CONVERT_INTEGER(long)
+YAML_DEFINE_CONVERT_INTEGER(long long)
+YAML_DEFINE_CONVERT_INTEGER(unsigned)
+YAML_DEFINE_CONVERT_INTEGER(unsigned short)
+YAML_DEFINE_CONVERT_INTEGER(unsigned long)
+YAML_DEFINE_CONVERT_INTEGER(unsigned long long)
+
+YAML_DEFINE_CONVERT_FLOAT(float)
+YAML_DEFINE_CONVERT_FLOAT(double)
+YAML_DEFINE_CONVERT_FLOAT(long double)
+
+#undef YAML_DEFINE_CONVERT_INTEGER
+#undef YAML_DEFINE_CONVERT_FLOAT
+
+// operator<< writes the character types as characters, while operator>>
+// reads plain char as a character and the others as numbers
+Node convert<char>::encode(const char& rhs) {
+  return Node(std::string(1, rhs));
+}
+
+bool convert<char>::decode(const Node& node, char& rhs) {
+  return node.IsScalar() && DecodeCharacter(node.Scalar(), rhs);
+}
+
+Node convert<signed char>::encode(const signed char& rhs) {
+  return Node(std::string(1, static_cast<char>(rhs)));
+}
+
+bool convert<signed char>::decode(const Node& node, signed char& rhs) {
+  return node.IsScalar() && DecodeInteger(node.Scalar(), rhs);
+}
+
+Node convert<unsigned char>::encode(const unsigned char& rhs) {
+  return Node(std::string(1, static_cast<char>(rhs)));
+}
+
+bool convert<unsigned char>::decode(const Node& node, unsigned char& rhs) {
+  return node.IsScalar() && DecodeInteger(node.Scalar(), rhs);
+}
 }  // namespace YAML
@@ -41,6 +41,9 @@ void EmitFromEvents::OnScalar(const Mark&, const std::string& tag,
                               anchor_t anchor, const std::string& value) {
   BeginNode();
   EmitProps(tag, anchor);
+  // the non-specific tag "!" marks a quoted scalar, which stays a string
+  if (tag == "!")
+    m_emitter << DoubleQuoted;
   m_emitter << value;
 }
 
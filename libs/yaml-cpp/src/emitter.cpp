@@ -90,6 +90,10 @@ bool Emitter::SetDoublePrecision(std::size_t n) {
   return m_pState->SetDoublePrecision(n, FmtScope::Global);
 }
 
+void Emitter::SetScalarFormatter(ScalarFormatter formatter) {
+  m_scalarFormatter = std::move(formatter);
+}
+
 void Emitter::RestoreGlobalModifiedSettings() {
   m_pState->RestoreGlobalModifiedSettings();
 }
@@ -719,29 +723,37 @@ Emitter& Emitter::Write(const std::string& str) {
   if (!good())
     return *this;
 
+  std::string formatted;
+  const bool isKey = m_pState->CurGroupType() == GroupType::Map &&
+                     m_pState->CurGroupChildCount() % 2 == 0;
+  const bool format = m_scalarFormatter && !isKey && !m_pState->HasTag() &&
+                      m_pState->GetStringFormat() == Auto;
+  const std::string& text =
+      format && m_scalarFormatter(str, formatted) ? formatted : str;
+
   StringEscaping::value stringEscaping = GetStringEscapingStyle(m_pState->GetOutputCharset());
 
   const StringFormat::value strFormat =
-      Utils::ComputeStringFormat(str, m_pState->GetStringFormat(),
+      Utils::ComputeStringFormat(text, m_pState->GetStringFormat(),
                                  m_pState->CurGroupFlowType(), stringEscaping == StringEscaping::NonAscii);
 
-  if (strFormat == StringFormat::Literal || str.size() > 1024)
+  if (strFormat == StringFormat::Literal || text.size() > 1024)
     m_pState->SetMapKeyFormat(YAML::LongKey, FmtScope::Local);
 
   PrepareNode(EmitterNodeType::Scalar);
 
   switch (strFormat) {
     case StringFormat::Plain:
-      m_stream << str;
+      m_stream << text;
       break;
     case StringFormat::SingleQuoted:
-      Utils::WriteSingleQuotedString(m_stream, str);
+      Utils::WriteSingleQuotedString(m_stream, text);
       break;
     case StringFormat::DoubleQuoted:
-      Utils::WriteDoubleQuotedString(m_stream, str, stringEscaping);
+      Utils::WriteDoubleQuotedString(m_stream, text, stringEscaping);
       break;
     case StringFormat::Literal:
-      Utils::WriteLiteralString(m_stream, str,
+      Utils::WriteLiteralString(m_stream, text,
                                 m_pState->CurIndent() + m_pState->GetIndent());
       break;
   }
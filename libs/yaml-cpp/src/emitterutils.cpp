@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <sstream>
 
+#include "bytescan.h"
 #include "emitterutils.h"
 #include "exp.h"
 #include "indentation.h"
@@ -87,9 +88,8 @@ int Utf8BytesIndicated(char ch) {
 
 bool IsTrailingByte(char ch) { return (ch & 0xC0) == 0x80; }
 
-bool GetNextCodePointAndAdvance(int& codePoint,
-                                std::string::const_iterator& first,
-                                std::string::const_iterator last) {
+bool GetNextCodePointAndAdvance(int& codePoint, const char*& first,
+                                const char* last) {
   if (first == last)
     return false;
 
@@ -152,6 +152,17 @@ void WriteCodePoint(ostream_wrapper& out, int codePoint) {
   }
 }
 
+// Writes the bytes before the next one that is special or outside printable
+// ASCII in one go and returns the position of that byte.
+const char* WritePrintableRun(ostream_wrapper& out, const char* first,
+                              const char* last, const ByteSet& special) {
+  const std::size_t n = FindByteOrNonPrintable(first, last, special);
+  if (n > 0) {
+    out.write(first, n);
+  }
+  return first + n;
+}
+
 bool IsValidPlainScalar(const std::string& str, FlowType::value flowType,
                         bool allowOnlyAscii) {
   // check against null
@@ -184,18 +195,34 @@ bool IsValidPlainScalar(const std::string& str, FlowType::value flowType,
   const RegEx& disallowed =
       flowType == FlowType::Flow ? disallowed_flow : disallowed_block;
 
-  StringCharSource buffer(str.c_str(), str.size());
-  while (buffer) {
-    if (disallowed.Matches(buffer)) {
-      return false;
+  // Only these bytes and those outside printable ASCII can start a match,
+  // except for the blank before a comment, which is checked from the '#'.
+  // Of the multi-byte sequences, only NotPrintable's C2 and the BOM's EF can.
+  static const ByteSet leads_flow(":#&,?[]{}");
+  static const ByteSet leads_block(":#&");
+  const ByteSet& leads = flowType == FlowType::Flow ? leads_flow : leads_block;
+
+  const char* const first = str.data();
+  const char* const last = first + str.size();
+  for (const char* p = first;; ++p) {
+    p += FindByteOrNonPrintable(p, last, leads);
+    if (p == last) {
+      return true;
+    }
+    if (0x80 <= static_cast<unsigned char>(*p)) {
+      if (allowOnlyAscii) {
+        return false;
+      }
+      if (*p != '\xC2' && *p != '\xEF') {
+        continue;
+      }
     }
-    if (allowOnlyAscii && (0x80 <= static_cast<unsigned char>(buffer[0]))) {
+    const char* start = *p == '#' && p != first ? p - 1 : p;
+    StringCharSource buffer(start, static_cast<std::size_t>(last - start));
+    if (disallowed.Matches(buffer)) {
       return false;
     }
-    ++buffer;
   }
-
-  return true;
 }
 
 bool IsValidSingleQuotedScalar(const std::string& str, bool escapeNonAscii) {
@@ -255,8 +282,8 @@ void WriteDoubleQuoteEscapeSequence(ostream_wrapper& out, int codePoint, StringE
 
 bool WriteAliasName(ostream_wrapper& out, const std::string& str) {
   int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  for (const char* i = str.data();
+       GetNextCodePointAndAdvance(codePoint, i, str.data() + str.size());) {
     if (!IsAnchorChar(codePoint)) {
       return false;
     }
@@ -297,10 +324,14 @@ StringFormat::value ComputeStringFormat(const std::string& str,
 }
 
 bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str) {
+  static const ByteSet special("'");
+
   out << "'";
+  const char* i = str.data();
+  const char* const last = i + str.size();
   int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  while ((i = WritePrintableRun(out, i, last, special)) != last) {
+    GetNextCodePointAndAdvance(codePoint, i, last);
     if (codePoint == '\n') {
       return false;  // We can't handle a new line and the attendant indentation
                      // yet
@@ -318,10 +349,14 @@ bool WriteSingleQuotedString(ostream_wrapper& out, const std::string& str) {
 
 bool WriteDoubleQuotedString(ostream_wrapper& out, const std::string& str,
                              StringEscaping::value stringEscaping) {
+  static const ByteSet special("\"\\");
+
   out << "\"";
+  const char* i = str.data();
+  const char* const last = i + str.size();
   int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  while ((i = WritePrintableRun(out, i, last, special)) != last) {
+    GetNextCodePointAndAdvance(codePoint, i, last);
     switch (codePoint) {
       case '\"':
         out << "\\\"";
@@ -365,14 +400,25 @@ bool WriteDoubleQuotedString(ostream_wrapper& out, const std::string& str,
 
 bool WriteLiteralString(ostream_wrapper& out, const std::string& str,
                         std::size_t indent) {
+  static const ByteSet special;
+
   out << "|\n";
+  const char* i = str.data();
+  const char* const last = i + str.size();
   int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  while (i != last) {
+    const std::size_t n = FindByteOrNonPrintable(i, last, special);
+    if (n > 0) {
+      out << IndentTo(indent);
+      out.write(i, n);
+      i += n;
+      continue;
+    }
+    GetNextCodePointAndAdvance(codePoint, i, last);
     if (codePoint == '\n') {
       out << "\n";
     } else {
-      out<< IndentTo(indent);
+      out << IndentTo(indent);
       WriteCodePoint(out, codePoint);
     }
   }
@@ -412,8 +458,8 @@ bool WriteComment(ostream_wrapper& out, const std::string& str,
   out << "#" << Indentation(postCommentIndent);
   out.set_comment();
   int codePoint;
-  for (std::string::const_iterator i = str.begin();
-       GetNextCodePointAndAdvance(codePoint, i, str.end());) {
+  for (const char* i = str.data();
+       GetNextCodePointAndAdvance(codePoint, i, str.data() + str.size());) {
     if (codePoint == '\n') {
       out << "\n"
           << IndentTo(curIndent) << "#" << Indentation(postCommentIndent);
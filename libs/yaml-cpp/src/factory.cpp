@@ -0,0 +1,60 @@
+#include "yaml-cpp/node/factory.h"
+#include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/node/detail/memory.h"
+#include "yaml-cpp/node/detail/node.h"
+#include "yaml-cpp/node/impl.h"
+
+namespace YAML {
+NodeFactory::NodeFactory() : m_pMemory(new detail::memory_holder) {}
+
+Node NodeFactory::Null() {
+  detail::node& node = m_pMemory->create_node();
+  node.set_null();
+  return Node(node, m_pMemory);
+}
+
+Node NodeFactory::Scalar(const std::string& value) {
+  detail::node& node = m_pMemory->create_node();
+  node.set_scalar(value);
+  return Node(node, m_pMemory);
+}
+
+Node NodeFactory::Sequence(std::size_t reserve, EmitterStyle::value style) {
+  detail::node& node = m_pMemory->create_node();
+  node.set_type(NodeType::Sequence);
+  node.set_style(style);
+  node.reserve(reserve);
+  return Node(node, m_pMemory);
+}
+
+Node NodeFactory::Map(std::size_t reserve, EmitterStyle::value style) {
+  detail::node& node = m_pMemory->create_node();
+  node.set_type(NodeType::Map);
+  node.set_style(style);
+  node.reserve(reserve);
+  return Node(node, m_pMemory);
+}
+
+void NodeFactory::Append(Node& sequence, const Node& value) {
+  if (sequence.Type() != NodeType::Sequence)
+    throw BadPushback();
+  Node v = Adopt(value);
+  sequence.m_pNode->push_back(*v.m_pNode, m_pMemory);
+}
+
+void NodeFactory::Append(Node& map, const Node& key, const Node& value) {
+  if (map.Type() != NodeType::Map)
+    throw BadSubscript(map.Mark(), key);
+  Node k = Adopt(key);
+  Node v = Adopt(value);
+  map.m_pNode->insert(*k.m_pNode, *v.m_pNode, m_pMemory);
+}
+
+// Nodes built elsewhere still work; their memory is merged once here.
+Node NodeFactory::Adopt(const Node& node) {
+  node.EnsureNodeExists();
+  if (node.m_pMemory != m_pMemory)
+    m_pMemory->merge(*node.m_pMemory);
+  return node;
+}
+}  // namespace YAML
@@ -1,9 +1,54 @@
+#include <algorithm>
+#include <new>
+
 #include "yaml-cpp/node/detail/memory.h"
 #include "yaml-cpp/node/detail/node.h"  // IWYU pragma: keep
 #include "yaml-cpp/node/ptr.h"
 
 namespace YAML {
 namespace detail {
+namespace {
+struct node_storage {
+  node_storage() : data{}, ref(data), value(ref) {}
+
+  node_data data;
+  node_ref ref;
+  node value;
+};
+
+const std::size_t kFirstBlockSize = 1;
+const std::size_t kMaxBlockSize = 1024;
+}  // namespace
+
+class memory::block {
+ public:
+  explicit block(std::size_t capacity)
+      : m_capacity(capacity),
+        m_size(0),
+        m_pStorage(static_cast<node_storage*>(
+            ::operator new(capacity * sizeof(node_storage)))) {}
+  block(const block&) = delete;
+  block& operator=(const block&) = delete;
+  ~block() {
+    while (m_size > 0)
+      m_pStorage[--m_size].~node_storage();
+    ::operator delete(m_pStorage);
+  }
+
+  std::size_t capacity() const { return m_capacity; }
+  bool full() const { return m_size == m_capacity; }
+
+  node& create_node() {
+    node_storage* pStorage = new (m_pStorage + m_size) node_storage;
+    ++m_size;
+    return pStorage->value;
+  }
+
+ private:
+  std::size_t m_capacity;
+  std::size_t m_size;
+  node_storage* m_pStorage;
+};
 
 void memory_holder::merge(memory_holder& rhs) {
   if (m_pMemory == rhs.m_pMemory)
@@ -14,13 +59,19 @@ void memory_holder::merge(memory_holder& rhs) {
 }
 
 node& memory::create_node() {
-  shared_node pNode(new node);
-  m_nodes.insert(pNode);
-  return *pNode;
+  if (!m_pCurrent || m_pCurrent->full()) {
+    const std::size_t capacity =
+        m_pCurrent ? std::min(m_pCurrent->capacity() * 2, kMaxBlockSize)
+                   : kFirstBlockSize;
+    std::shared_ptr<block> pBlock = std::make_shared<block>(capacity);
+    m_blocks.insert(pBlock);
+    m_pCurrent = pBlock.get();
+  }
+  return m_pCurrent->create_node();
 }
 
 void memory::merge(const memory& rhs) {
-  m_nodes.insert(rhs.m_nodes.begin(), rhs.m_nodes.end());
+  m_blocks.insert(rhs.m_blocks.begin(), rhs.m_blocks.end());
 }
 }  // namespace detail
 }  // namespace YAML
@@ -206,6 +206,19 @@ void node_data::insert(node& key, node& value,
   insert_map_pair(key, value);
 }
 
+void node_data::reserve(std::size_t n) {
+  switch (m_type) {
+    case NodeType::Sequence:
+      m_sequence.reserve(n);
+      break;
+    case NodeType::Map:
+      m_map.reserve(n);
+      break;
+    default:
+      break;
+  }
+}
+
 // indexing
 node* node_data::get(node& key,
                      const shared_memory_holder& /* pMemory */) const {
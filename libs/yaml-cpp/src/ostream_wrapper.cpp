@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 
 namespace YAML {
 ostream_wrapper::ostream_wrapper()
@@ -24,16 +25,7 @@ ostream_wrapper::ostream_wrapper(std::ostream& stream)
 ostream_wrapper::~ostream_wrapper() = default;
 
 void ostream_wrapper::write(const std::string& str) {
-  if (m_pStream) {
-    m_pStream->write(str.c_str(), str.size());
-  } else {
-    m_buffer.resize(std::max(m_buffer.size(), m_pos + str.size() + 1));
-    std::copy(str.begin(), str.end(), m_buffer.begin() + m_pos);
-  }
-
-  for (char ch : str) {
-    update_pos(ch);
-  }
+  write(str.data(), str.size());
 }
 
 void ostream_wrapper::write(const char* str, std::size_t size) {
@@ -44,19 +36,25 @@ void ostream_wrapper::write(const char* str, std::size_t size) {
     std::copy(str, str + size, m_buffer.begin() + m_pos);
   }
 
-  for (std::size_t i = 0; i < size; i++) {
-    update_pos(str[i]);
-  }
+  update_pos(str, size);
 }
 
-void ostream_wrapper::update_pos(char ch) {
-  m_pos++;
-  m_col++;
+void ostream_wrapper::update_pos(const char* str, std::size_t size) {
+  m_pos += size;
 
-  if (ch == '\n') {
-    m_row++;
-    m_col = 0;
-    m_comment = false;
+  const char* const last = str + size;
+  const char* newline =
+      static_cast<const char*>(std::memchr(str, '\n', size));
+  if (!newline) {
+    m_col += size;
+    return;
   }
+
+  m_row += static_cast<std::size_t>(std::count(newline, last, '\n'));
+  m_col = static_cast<std::size_t>(
+      last - std::find(std::make_reverse_iterator(last),
+                       std::make_reverse_iterator(newline), '\n')
+                 .base());
+  m_comment = false;
 }
 }  // namespace YAML
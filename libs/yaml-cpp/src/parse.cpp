@@ -1,7 +1,7 @@
 #include "yaml-cpp/node/parse.h"
 
+#include <cstring>
 #include <fstream>
-#include <sstream>
 
 #include "nodebuilder.h"
 #include "yaml-cpp/node/impl.h"
@@ -9,24 +9,45 @@
 #include "yaml-cpp/parser.h"
 
 namespace YAML {
+namespace {
+Node LoadFrom(Parser& parser) {
+  NodeBuilder builder;
+  if (!parser.HandleNextDocument(builder)) {
+    return Node();
+  }
+
+  return builder.Root();
+}
+
+std::vector<Node> LoadAllFrom(Parser& parser) {
+  std::vector<Node> docs;
+
+  while (true) {
+    NodeBuilder builder;
+    if (!parser.HandleNextDocument(builder)) {
+      break;
+    }
+    docs.push_back(builder.Root());
+  }
+
+  return docs;
+}
+}  // namespace
+
 Node Load(const std::string& input) {
-  std::stringstream stream(input);
-  return Load(stream);
+  return Load(input.data(), input.size());
 }
 
-Node Load(const char* input) {
-  std::stringstream stream(input);
-  return Load(stream);
+Node Load(const char* input) { return Load(input, std::strlen(input)); }
+
+Node Load(const char* input, std::size_t size) {
+  Parser parser(input, size);
+  return LoadFrom(parser);
 }
 
 Node Load(std::istream& input) {
   Parser parser(input);
-  NodeBuilder builder;
-  if (!parser.HandleNextDocument(builder)) {
-    return Node();
-  }
-
-  return builder.Root();
+  return LoadFrom(parser);
 }
 
 Node LoadFile(const std::string& filename) {
@@ -38,28 +59,21 @@ Node LoadFile(const std::string& filename) {
 }
 
 std::vector<Node> LoadAll(const std::string& input) {
-  std::stringstream stream(input);
-  return LoadAll(stream);
+  return LoadAll(input.data(), input.size());
 }
 
 std::vector<Node> LoadAll(const char* input) {
-  std::stringstream stream(input);
-  return LoadAll(stream);
+  return LoadAll(input, std::strlen(input));
 }
 
-std::vector<Node> LoadAll(std::istream& input) {
-  std::vector<Node> docs;
+std::vector<Node> LoadAll(const char* input, std::size_t size) {
+  Parser parser(input, size);
+  return LoadAllFrom(parser);
+}
 
+std::vector<Node> LoadAll(std::istream& input) {
   Parser parser(input);
-  while (true) {
-    NodeBuilder builder;
-    if (!parser.HandleNextDocument(builder)) {
-      break;
-    }
-    docs.push_back(builder.Root());
-  }
-
-  return docs;
+  return LoadAllFrom(parser);
 }
 
 std::vector<Node> LoadAllFromFile(const std::string& filename) {
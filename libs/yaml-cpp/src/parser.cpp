@@ -15,6 +15,10 @@ Parser::Parser() : m_pScanner{}, m_pDirectives{} {}
 
 Parser::Parser(std::istream& in) : Parser() { Load(in); }
 
+Parser::Parser(const char* data, std::size_t size) : Parser() {
+  Load(data, size);
+}
+
 Parser::~Parser() = default;
 
 Parser::operator bool() const { return m_pScanner && !m_pScanner->empty(); }
@@ -24,6 +28,11 @@ void Parser::Load(std::istream& in) {
   m_pDirectives.reset(new Directives);
 }
 
+void Parser::Load(const char* data, std::size_t size) {
+  m_pScanner.reset(new Scanner(data, size));
+  m_pDirectives.reset(new Directives);
+}
+
 bool Parser::HandleNextDocument(EventHandler& eventHandler) {
   if (!m_pScanner)
     return false;
@@ -76,13 +85,14 @@ void Parser::HandleYamlDirective(const Token& token) {
     throw ParserException(token.mark, ErrorMsg::REPEATED_YAML_DIRECTIVE);
   }
 
-  std::stringstream str(token.params[0]);
+  std::stringstream str{std::string(token.params[0])};
   str >> m_pDirectives->version.major;
   str.get();
   str >> m_pDirectives->version.minor;
   if (!str || str.peek() != EOF) {
     throw ParserException(
-        token.mark, std::string(ErrorMsg::YAML_VERSION) + token.params[0]);
+        token.mark,
+        std::string(ErrorMsg::YAML_VERSION) + std::string(token.params[0]));
   }
 
   if (m_pDirectives->version.major > 1) {
@@ -97,8 +107,8 @@ void Parser::HandleTagDirective(const Token& token) {
   if (token.params.size() != 2)
     throw ParserException(token.mark, ErrorMsg::TAG_DIRECTIVE_ARGS);
 
-  const std::string& handle = token.params[0];
-  const std::string& prefix = token.params[1];
+  const std::string handle(token.params[0]);
+  const std::string prefix(token.params[1]);
   if (m_pDirectives->tags.find(handle) != m_pDirectives->tags.end()) {
     throw ParserException(token.mark, ErrorMsg::REPEATED_TAG_DIRECTIVE);
   }
@@ -1,5 +1,7 @@
 #include "regex_yaml.h"
 
+#include <map>
+
 namespace YAML {
 // constructors
 
@@ -40,4 +42,140 @@ RegEx operator+(const RegEx& ex1, const RegEx& ex2) {
   ret.m_params.push_back(ex2);
   return ret;
 }
+
+// compilation
+RegExTable::RegExTable(std::vector<State> states, int start)
+    : m_states(std::move(states)), m_start(start), m_leads{} {
+  for (int ch = 0; ch < 256; ch++) {
+    if (m_start < 0 ? m_start != -1 : m_states[m_start][ch] != -1)
+      m_leads += static_cast<char>(ch);
+  }
+}
+
+namespace {
+// Reads a fixed prefix of the input and notes any attempt to look past it.
+class ProbeSource {
+ public:
+  ProbeSource(const std::string& prefix, bool& overrun)
+      : m_prefix(prefix), m_overrun(overrun), m_offset(0) {}
+
+  operator bool() const { return true; }
+  bool operator!() const { return false; }
+  char operator[](std::size_t i) const {
+    if (m_offset + i < m_prefix.size())
+      return m_prefix[m_offset + i];
+    m_overrun = true;
+    return Stream::eof();
+  }
+  ProbeSource operator+(int i) const {
+    ProbeSource source(*this);
+    if (static_cast<int>(source.m_offset) + i >= 0)
+      source.m_offset += static_cast<std::size_t>(i);
+    else
+      source.m_offset = 0;
+    return source;
+  }
+
+ private:
+  const std::string& m_prefix;
+  bool& m_overrun;
+  std::size_t m_offset;
+};
+
+// Builds the table by running the expression on every distinguishable
+// prefix. Characters that no MATCH, RANGE or EMPTY leaf tells apart share a
+// class, so each state only branches once per class.
+class TableBuilder {
+ public:
+  TableBuilder(const RegEx& ex, const std::vector<std::string>& signatures)
+      : m_ex(ex), m_failed(false) {
+    std::map<std::string, std::size_t> classes;
+    for (int ch = 0; ch < 256; ch++) {
+      auto it = classes.emplace(signatures[ch], m_representatives.size());
+      if (it.second)
+        m_representatives.push_back(static_cast<char>(ch));
+      m_classOf[ch] = it.first->second;
+    }
+  }
+
+  std::shared_ptr<const RegExTable> Build() {
+    std::string prefix;
+    int start = Build(prefix);
+    if (m_failed)
+      return nullptr;
+    return std::make_shared<const RegExTable>(std::move(m_states), start);
+  }
+
+ private:
+  // enough for the longest lookahead in exp.h, with room to spare
+  static constexpr std::size_t kMaxLookahead = 8;
+
+  int Build(std::string& prefix) {
+    bool overrun = false;
+    int n = m_ex.Match(ProbeSource(prefix, overrun));
+    if (!overrun)
+      return -n - 2;
+    if (prefix.size() == kMaxLookahead) {
+      m_failed = true;
+      return -1;
+    }
+
+    std::vector<int> next(m_representatives.size());
+    for (std::size_t i = 0; i < next.size() && !m_failed; i++) {
+      prefix.push_back(m_representatives[i]);
+      next[i] = Build(prefix);
+      prefix.pop_back();
+    }
+    if (m_failed)
+      return -1;
+
+    RegExTable::State state;
+    for (int ch = 0; ch < 256; ch++)
+      state[ch] = static_cast<std::int16_t>(next[m_classOf[ch]]);
+    auto it = m_index.find(state);
+    if (it != m_index.end())
+      return it->second;
+    if (m_states.size() > 0x7fff) {
+      m_failed = true;
+      return -1;
+    }
+    int index = static_cast<int>(m_states.size());
+    m_states.push_back(state);
+    m_index.emplace(state, index);
+    return index;
+  }
+
+  const RegEx& m_ex;
+  bool m_failed;
+  std::size_t m_classOf[256];
+  std::vector<char> m_representatives;
+  std::vector<RegExTable::State> m_states;
+  std::map<RegExTable::State, int> m_index;
+};
+}  // namespace
+
+RegEx Compile(const RegEx& ex) {
+  std::vector<std::string> signatures(256);
+  std::vector<const RegEx*> pending{&ex};
+  while (!pending.empty()) {
+    const RegEx& leaf = *pending.back();
+    pending.pop_back();
+    for (const RegEx& param : leaf.m_params)
+      pending.push_back(&param);
+    if (leaf.m_op != REGEX_EMPTY && leaf.m_op != REGEX_MATCH &&
+        leaf.m_op != REGEX_RANGE)
+      continue;
+    for (int i = 0; i < 256; i++) {
+      char ch = static_cast<char>(i);
+      bool hit = leaf.m_op == REGEX_EMPTY   ? ch == Stream::eof()
+                 : leaf.m_op == REGEX_MATCH ? ch == leaf.m_a
+                                            : leaf.m_a <= ch && ch <= leaf.m_z;
+      signatures[i] += hit ? '1' : '0';
+    }
+  }
+
+  RegEx ret(ex);
+  ret.m_pTable = TableBuilder(ex, signatures).Build();
+  return ret;
+}
 }  // namespace YAML
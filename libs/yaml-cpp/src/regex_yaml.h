@@ -7,6 +7,9 @@
 #pragma once
 #endif
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,6 +17,7 @@
 
 namespace YAML {
 class Stream;
+class RegExTable;
 
 enum REGEX_OP {
   REGEX_EMPTY,
@@ -41,12 +45,19 @@ class YAML_CPP_API RegEx {
   friend YAML_CPP_API RegEx operator&(const RegEx& ex1, const RegEx& ex2);
   friend YAML_CPP_API RegEx operator+(const RegEx& ex1, const RegEx& ex2);
 
+  // Returns a copy of ex that matches streams through a RegExTable. An
+  // expression that looks too far ahead is returned as it is.
+  friend YAML_CPP_API RegEx Compile(const RegEx& ex);
+
   bool Matches(char ch) const;
   bool Matches(const std::string& str) const;
   bool Matches(const Stream& in) const;
   template <typename Source>
   bool Matches(const Source& source) const;
 
+  // bytes a stream match can begin with, if compiled; null otherwise
+  const std::string* Leads() const;
+
   int Match(const std::string& str) const;
   int Match(const Stream& in) const;
   template <typename Source>
@@ -80,6 +91,24 @@ class YAML_CPP_API RegEx {
   char m_a{};
   char m_z{};
   std::vector<RegEx> m_params;
+  std::shared_ptr<const RegExTable> m_pTable;
+};
+
+// A RegEx unrolled over its lookahead. Each state maps the next character
+// either to another state or, when negative, to the result -(n + 2) of Match.
+class RegExTable {
+ public:
+  using State = std::array<std::int16_t, 256>;
+
+  RegExTable(std::vector<State> states, int start);
+
+  int Match(const Stream& in) const;
+  const std::string& Leads() const { return m_leads; }
+
+ private:
+  std::vector<State> m_states;
+  int m_start;
+  std::string m_leads;
 };
 }  // namespace YAML
 
@@ -25,6 +25,10 @@ inline bool RegEx::Matches(const std::string& str) const {
 
 inline bool RegEx::Matches(const Stream& in) const { return Match(in) >= 0; }
 
+inline const std::string* RegEx::Leads() const {
+  return m_pTable ? &m_pTable->Leads() : nullptr;
+}
+
 template <typename Source>
 inline bool RegEx::Matches(const Source& source) const {
   return Match(source) >= 0;
@@ -43,10 +47,19 @@ inline int RegEx::Match(const std::string& str) const {
 }
 
 inline int RegEx::Match(const Stream& in) const {
+  if (m_pTable)
+    return m_pTable->Match(in);
   StreamCharSource source(in);
   return Match(source);
 }
 
+inline int RegExTable::Match(const Stream& in) const {
+  int next = m_start;
+  for (std::size_t i = 0; next >= 0; i++)
+    next = m_states[next][static_cast<unsigned char>(in.peek(i))];
+  return -next - 2;
+}
+
 template <typename Source>
 inline bool RegEx::IsValidSource(const Source& source) const {
   return source;
@@ -1,6 +1,6 @@
 #include <cassert>
-#include <memory>
 
+#include "bytescan.h"
 #include "exp.h"
 #include "scanner.h"
 #include "token.h"
@@ -10,6 +10,20 @@ namespace YAML {
 Scanner::Scanner(std::istream& in)
     : INPUT(in),
       m_tokens{},
+      m_text{},
+      m_startedStream(false),
+      m_endedStream(false),
+      m_simpleKeyAllowed(false),
+      m_canBeJSONFlow(false),
+      m_simpleKeys{},
+      m_indents{},
+      m_indentRefs{},
+      m_flows{} {}
+
+Scanner::Scanner(const char* data, std::size_t size)
+    : INPUT(data, size),
+      m_tokens{},
+      m_text{},
       m_startedStream(false),
       m_endedStream(false),
       m_simpleKeyAllowed(false),
@@ -177,6 +191,10 @@ void Scanner::ScanToNextToken() {
   while (true) {
     // first eat whitespace
     while (INPUT && IsWhitespaceToBeEaten(INPUT.peek())) {
+      if (INPUT.buffer() && INPUT.peek() == ' ') {
+        INPUT.eatInLine(SkipByte(INPUT.buffer(), INPUT.bufferEnd(), ' '));
+        continue;
+      }
       if (InBlockContext() && Exp::Tab().Matches(INPUT)) {
         m_simpleKeyAllowed = false;
       }
@@ -186,6 +204,11 @@ void Scanner::ScanToNextToken() {
     // then eat a comment
     if (Exp::Comment().Matches(INPUT)) {
       // eat until line break
+      if (INPUT.buffer()) {
+        static const ByteSet lineBreaks("\n\r");
+        INPUT.eatInLine(
+            FindByte(INPUT.buffer(), INPUT.bufferEnd(), lineBreaks));
+      }
       while (INPUT && !Exp::Break().Matches(INPUT)) {
         INPUT.eat(1);
       }
@@ -245,9 +268,7 @@ const RegEx& Scanner::GetValueRegex() const {
 void Scanner::StartStream() {
   m_startedStream = true;
   m_simpleKeyAllowed = true;
-  std::unique_ptr<IndentMarker> pIndent(
-      new IndentMarker(-1, IndentMarker::NONE));
-  m_indentRefs.push_back(std::move(pIndent));
+  m_indentRefs.emplace_back(-1, IndentMarker::NONE);
   m_indents.push(&m_indentRefs.back());
 }
 
@@ -290,8 +311,7 @@ Scanner::IndentMarker* Scanner::PushIndentTo(int column,
     return nullptr;
   }
 
-  std::unique_ptr<IndentMarker> pIndent(new IndentMarker(column, type));
-  IndentMarker& indent = *pIndent;
+  IndentMarker indent(column, type);
   const IndentMarker& lastIndent = *m_indents.top();
 
   // is this actually an indentation?
@@ -308,8 +328,8 @@ Scanner::IndentMarker* Scanner::PushIndentTo(int column,
   indent.pStartToken = PushToken(GetStartTokenFor(type));
 
   // and then the indent
-  m_indents.push(&indent);
-  m_indentRefs.push_back(std::move(pIndent));
+  m_indentRefs.push_back(indent);
+  m_indents.push(&m_indentRefs.back());
   return &m_indentRefs.back();
 }
 
@@ -373,6 +393,15 @@ void Scanner::PopIndent() {
   }
 }
 
+std::string_view Scanner::KeepText(const char* start, const std::string& text) {
+  if (start &&
+      text.size() <= static_cast<std::size_t>(INPUT.buffer() - start) &&
+      text.compare(0, text.size(), start, text.size()) == 0) {
+    return std::string_view(start, text.size());
+  }
+  return m_tokens.Keep(text);
+}
+
 int Scanner::GetTopIndent() const {
   if (m_indents.empty()) {
     return 0;
@@ -8,14 +8,15 @@
 #endif
 
 #include <cstddef>
+#include <deque>
 #include <ios>
-#include <queue>
 #include <stack>
 #include <string>
+#include <string_view>
 
-#include "ptr_vector.h"
 #include "stream.h"
 #include "token.h"
+#include "tokenqueue.h"
 #include "yaml-cpp/mark.h"
 
 namespace YAML {
@@ -28,6 +29,7 @@ class RegEx;
 class Scanner {
  public:
   explicit Scanner(std::istream &in);
+  Scanner(const char *data, std::size_t size);
   ~Scanner();
 
   /** Returns true if there are no more tokens to be read. */
@@ -131,6 +133,13 @@ class Scanner {
 
   bool IsWhitespaceToBeEaten(char ch);
 
+  /**
+   * Returns text for a token: a view of the input if text is what the input
+   * holds from start on, otherwise a copy kept by the token queue. start is
+   * null when the input is not contiguous.
+   */
+  std::string_view KeepText(const char *start, const std::string &text);
+
   /**
    * Returns the appropriate regex to check if the next token is a value token.
    */
@@ -172,7 +181,8 @@ class Scanner {
   Stream INPUT;
 
   // the output (tokens)
-  std::queue<Token> m_tokens;
+  TokenQueue m_tokens;
+  std::string m_text;  // reused while scanning token text
 
   // state info
   bool m_startedStream, m_endedStream;
@@ -180,7 +190,7 @@ class Scanner {
   bool m_canBeJSONFlow;
   std::stack<SimpleKey> m_simpleKeys;
   std::stack<IndentMarker *> m_indents;
-  ptr_vector<IndentMarker> m_indentRefs;  // for "garbage collection"
+  std::deque<IndentMarker> m_indentRefs;  // for "garbage collection"
   std::stack<FLOW_MARKER> m_flows;
 };
 }
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "bytescan.h"
 #include "exp.h"
 #include "regeximpl.h"
 #include "stream.h"
@@ -18,20 +19,29 @@ namespace YAML {
 //
 // . Depending on the parameters given, we store or stop
 //   and different places in the above flow.
-std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
+void ScanScalar(Stream& INPUT, ScanScalarParams& params, std::string& scalar) {
   bool foundNonEmptyLine = false;
   bool pastOpeningBreak = (params.fold == FOLD_FLOW);
   bool emptyLine = false, moreIndented = false;
   int foldedNewlineCount = 0;
   bool foldedNewlineStartedMoreIndented = false;
   std::size_t lastEscapedChar = std::string::npos;
-  std::string scalar;
+  scalar.clear();
   params.leadingSpaces = false;
 
   if (!params.end) {
     params.end = &Exp::Empty();
   }
 
+  // On contiguous input, runs of bytes that can neither end the scalar, break
+  // the line nor start an escape are copied in bulk. (An escape of 0 still
+  // counts: the loop below compares against it regardless.)
+  ByteSet stops("\n\r");
+  const std::string* leads = params.end->Leads();
+  bool bulk = INPUT.buffer() && leads && stops.Add(params.escape);
+  for (std::size_t i = 0; bulk && i < leads->size(); i++)
+    bulk = stops.Add((*leads)[i]);
+
   while (INPUT) {
     // ********************************
     // Phase #1: scan until line ending
@@ -43,6 +53,24 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
         break;
       }
 
+      if (bulk && INPUT.column() > 0) {
+        const char* run = INPUT.buffer();
+        std::size_t n = FindByte(run, INPUT.bufferEnd(), stops);
+        if (n > 0) {
+          scalar.append(run, n);
+          std::size_t blanks = 0;
+          while (blanks < n && (run[n - blanks - 1] == ' ' ||
+                                run[n - blanks - 1] == '\t'))
+            blanks++;
+          if (blanks < n)
+            lastNonWhitespaceChar = scalar.size() - blanks;
+          foundNonEmptyLine = true;
+          pastOpeningBreak = true;
+          INPUT.eatInLine(n);
+          continue;
+        }
+      }
+
       // document indicator?
       if (INPUT.column() == 0 && Exp::DocIndicator().Matches(INPUT)) {
         if (params.onDocIndicator == BREAK) {
@@ -173,7 +201,7 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
           }
 
           if (!nextEmptyLine && foldedNewlineCount > 0) {
-            scalar += std::string(foldedNewlineCount - 1, '\n');
+            scalar.append(foldedNewlineCount - 1, '\n');
             if (foldedNewlineStartedMoreIndented ||
                 nextMoreIndented | !foundNonEmptyLine) {
               scalar += "\n";
@@ -245,7 +273,5 @@ std::string ScanScalar(Stream& INPUT, ScanScalarParams& params) {
     default:
       break;
   }
-
-  return scalar;
 }
 }  // namespace YAML
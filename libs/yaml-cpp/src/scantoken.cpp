@@ -18,9 +18,6 @@ namespace YAML {
 // Directive
 // . Note: no semantic checking is done here (that's for the parser to do)
 void Scanner::ScanDirective() {
-  std::string name;
-  std::vector<std::string> params;
-
   // pop indents and simple keys
   PopAllIndents();
   PopAllSimpleKeys();
@@ -33,8 +30,10 @@ void Scanner::ScanDirective() {
   INPUT.eat(1);
 
   // read name
+  m_text.clear();
   while (INPUT && !Exp::BlankOrBreak().Matches(INPUT))
-    token.value += INPUT.get();
+    m_text += INPUT.get();
+  token.value = m_tokens.Keep(m_text);
 
   // read parameters
   while (true) {
@@ -47,14 +46,14 @@ void Scanner::ScanDirective() {
       break;
 
     // now read parameter
-    std::string param;
+    m_text.clear();
     while (INPUT && !Exp::BlankOrBreak().Matches(INPUT))
-      param += INPUT.get();
+      m_text += INPUT.get();
 
-    token.params.push_back(param);
+    token.params.push_back(m_tokens.Keep(m_text));
   }
 
-  m_tokens.push(token);
+  m_tokens.push(std::move(token));
 }
 
 // DocStart
@@ -220,7 +219,6 @@ void Scanner::ScanValue() {
 // AnchorOrAlias
 void Scanner::ScanAnchorOrAlias() {
   bool alias;
-  std::string name;
 
   // insert a potential simple key
   InsertPotentialSimpleKey();
@@ -233,11 +231,13 @@ void Scanner::ScanAnchorOrAlias() {
   alias = (indicator == Keys::Alias);
 
   // now eat the content
+  const char* start = INPUT.buffer();
+  m_text.clear();
   while (INPUT && Exp::Anchor().Matches(INPUT))
-    name += INPUT.get();
+    m_text += INPUT.get();
 
   // we need to have read SOMETHING!
-  if (name.empty())
+  if (m_text.empty())
     throw ParserException(INPUT.mark(), alias ? ErrorMsg::ALIAS_NOT_FOUND
                                               : ErrorMsg::ANCHOR_NOT_FOUND);
 
@@ -248,8 +248,8 @@ void Scanner::ScanAnchorOrAlias() {
 
   // and we're done
   Token token(alias ? Token::ALIAS : Token::ANCHOR, mark);
-  token.value = name;
-  m_tokens.push(token);
+  token.value = KeepText(start, m_text);
+  m_tokens.push(std::move(token));
 }
 
 // Tag
@@ -265,13 +265,11 @@ void Scanner::ScanTag() {
   INPUT.get();
 
   if (INPUT && INPUT.peek() == Keys::VerbatimTagStart) {
-    std::string tag = ScanVerbatimTag(INPUT);
-
-    token.value = tag;
+    token.value = m_tokens.Keep(ScanVerbatimTag(INPUT));
     token.data = Tag::VERBATIM;
   } else {
     bool canBeHandle;
-    token.value = ScanTagHandle(INPUT, canBeHandle);
+    token.value = m_tokens.Keep(ScanTagHandle(INPUT, canBeHandle));
     if (!canBeHandle && token.value.empty())
       token.data = Tag::NON_SPECIFIC;
     else if (token.value.empty())
@@ -283,18 +281,16 @@ void Scanner::ScanTag() {
     if (canBeHandle && INPUT.peek() == Keys::Tag) {
       // eat the indicator
       INPUT.get();
-      token.params.push_back(ScanTagSuffix(INPUT));
+      token.params.push_back(m_tokens.Keep(ScanTagSuffix(INPUT)));
       token.data = Tag::NAMED_HANDLE;
     }
   }
 
-  m_tokens.push(token);
+  m_tokens.push(std::move(token));
 }
 
 // PlainScalar
 void Scanner::ScanPlainScalar() {
-  std::string scalar;
-
   // set up the scanning parameters
   ScanScalarParams params;
   params.end =
@@ -312,7 +308,8 @@ void Scanner::ScanPlainScalar() {
   InsertPotentialSimpleKey();
 
   Mark mark = INPUT.mark();
-  scalar = ScanScalar(INPUT, params);
+  const char* start = INPUT.buffer();
+  ScanScalar(INPUT, params, m_text);
 
   // can have a simple key only if we ended the scalar by starting a new line
   m_simpleKeyAllowed = params.leadingSpaces;
@@ -323,14 +320,12 @@ void Scanner::ScanPlainScalar() {
   //	throw ParserException(INPUT.mark(), ErrorMsg::CHAR_IN_SCALAR);
 
   Token token(Token::PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  token.value = KeepText(start, m_text);
+  m_tokens.push(std::move(token));
 }
 
 // QuotedScalar
 void Scanner::ScanQuotedScalar() {
-  std::string scalar;
-
   // peek at single or double quote (don't eat because we need to preserve (for
   // the time being) the input position)
   char quote = INPUT.peek();
@@ -338,8 +333,10 @@ void Scanner::ScanQuotedScalar() {
 
   // setup the scanning parameters
   ScanScalarParams params;
-  RegEx end = (single ? RegEx(quote) & !Exp::EscSingleQuote() : RegEx(quote));
-  params.end = &end;
+  static const RegEx singleEnd =
+      Compile(RegEx('\'') & !Exp::EscSingleQuote());
+  static const RegEx doubleEnd = Compile(RegEx('\"'));
+  params.end = (single ? &singleEnd : &doubleEnd);
   params.eatEnd = true;
   params.escape = (single ? '\'' : '\\');
   params.indent = 0;
@@ -358,13 +355,14 @@ void Scanner::ScanQuotedScalar() {
   INPUT.get();
 
   // and scan
-  scalar = ScanScalar(INPUT, params);
+  const char* start = INPUT.buffer();
+  ScanScalar(INPUT, params, m_text);
   m_simpleKeyAllowed = false;
   m_canBeJSONFlow = true;
 
   Token token(Token::NON_PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  token.value = KeepText(start, m_text);
+  m_tokens.push(std::move(token));
 }
 
 // BlockScalarToken
@@ -373,8 +371,6 @@ void Scanner::ScanQuotedScalar() {
 // of the scalar),
 //   and then we need to figure out what level of indentation we'll be using.
 void Scanner::ScanBlockScalar() {
-  std::string scalar;
-
   ScanScalarParams params;
   params.indent = 1;
   params.detectIndent = true;
@@ -423,7 +419,7 @@ void Scanner::ScanBlockScalar() {
   params.trimTrailingSpaces = false;
   params.onTabInIndentation = THROW;
 
-  scalar = ScanScalar(INPUT, params);
+  ScanScalar(INPUT, params, m_text);
 
   // simple keys always ok after block scalars (since we're gonna start a new
   // line anyways)
@@ -431,7 +427,7 @@ void Scanner::ScanBlockScalar() {
   m_canBeJSONFlow = false;
 
   Token token(Token::NON_PLAIN_SCALAR, mark);
-  token.value = scalar;
-  m_tokens.push(token);
+  token.value = m_tokens.Keep(m_text);
+  m_tokens.push(std::move(token));
 }
 }  // namespace YAML
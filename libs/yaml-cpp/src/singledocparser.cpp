@@ -20,6 +20,7 @@ SingleDocParser::SingleDocParser(Scanner& scanner, const Directives& directives)
       m_directives(directives),
       m_pCollectionStack(new CollectionStack),
       m_anchors{},
+      m_scalar{},
       m_curAnchor(0) {}
 
 SingleDocParser::~SingleDocParser() = default;
@@ -93,9 +94,13 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
   // add non-specific tags
   if (tag.empty())
     tag = (token.type == Token::NON_PLAIN_SCALAR ? "!" : "?");
-  
+
+  if (token.type == Token::PLAIN_SCALAR ||
+      token.type == Token::NON_PLAIN_SCALAR)
+    m_scalar.assign(token.value);
+
   if (token.type == Token::PLAIN_SCALAR 
-      && tag.compare("?") == 0 && IsNullString(token.value)) {
+      && tag.compare("?") == 0 && IsNullString(m_scalar)) {
     eventHandler.OnNull(mark, anchor);
     m_scanner.pop();
     return;
@@ -105,7 +110,7 @@ void SingleDocParser::HandleNode(EventHandler& eventHandler) {
   switch (token.type) {
     case Token::PLAIN_SCALAR:
     case Token::NON_PLAIN_SCALAR:
-      eventHandler.OnScalar(mark, tag, anchor, token.value);
+      eventHandler.OnScalar(mark, tag, anchor, m_scalar);
       m_scanner.pop();
       return;
     case Token::FLOW_SEQ_START:
@@ -409,8 +414,8 @@ void SingleDocParser::ParseAnchor(anchor_t& anchor, std::string& anchor_name) {
   if (anchor)
     throw ParserException(token.mark, ErrorMsg::MULTIPLE_ANCHORS);
 
-  anchor_name = token.value;
-  anchor = RegisterAnchor(token.value);
+  anchor_name.assign(token.value);
+  anchor = RegisterAnchor(anchor_name);
   m_scanner.pop();
 }
 
@@ -422,7 +427,7 @@ anchor_t SingleDocParser::RegisterAnchor(const std::string& name) {
 }
 
 anchor_t SingleDocParser::LookupAnchor(const Mark& mark,
-                                       const std::string& name) const {
+                                       std::string_view name) const {
   auto it = m_anchors.find(name);
   if (it == m_anchors.end()) {
     std::stringstream ss;
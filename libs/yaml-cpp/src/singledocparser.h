@@ -7,9 +7,11 @@
 #pragma once
 #endif
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "yaml-cpp/anchor.h"
 
@@ -53,7 +55,7 @@ class SingleDocParser {
   void ParseAnchor(anchor_t& anchor, std::string& anchor_name);
 
   anchor_t RegisterAnchor(const std::string& name);
-  anchor_t LookupAnchor(const Mark& mark, const std::string& name) const;
+  anchor_t LookupAnchor(const Mark& mark, std::string_view name) const;
 
  private:
   int depth = 0;
@@ -61,9 +63,11 @@ class SingleDocParser {
   const Directives& m_directives;
   std::unique_ptr<CollectionStack> m_pCollectionStack;
 
-  using Anchors = std::map<std::string, anchor_t>;
+  using Anchors = std::map<std::string, anchor_t, std::less<>>;
   Anchors m_anchors;
 
+  std::string m_scalar;  // the current scalar, as handed to the EventHandler
+
   anchor_t m_curAnchor;
 };
 }  // namespace YAML
@@ -182,37 +182,124 @@ inline void QueueUnicodeCodepoint(std::deque<char>& q, unsigned long ch) {
   }
 }
 
+namespace {
+// Reads the BOM candidates from an istream; see Stream::DetectCharSet.
+class IntroStreamSource {
+ public:
+  explicit IntroStreamSource(std::istream& input) : m_input(input) {}
+
+  std::istream::int_type get() { return m_input.get(); }
+  void unget(std::istream::int_type ch) {
+    m_input.clear();
+    if (std::istream::traits_type::eof() != ch)
+      m_input.putback(std::istream::traits_type::to_char_type(ch));
+  }
+
+ private:
+  std::istream& m_input;
+};
+
+// Reads the BOM candidates from a buffer; pos() ends up past the BOM.
+class IntroBufferSource {
+ public:
+  IntroBufferSource(const char* data, std::size_t size)
+      : m_data(data), m_size(size), m_pos(0) {}
+
+  std::istream::int_type get() {
+    if (m_pos >= m_size)
+      return std::istream::traits_type::eof();
+    return static_cast<unsigned char>(m_data[m_pos++]);
+  }
+  void unget(std::istream::int_type ch) {
+    if (std::istream::traits_type::eof() != ch)
+      --m_pos;
+  }
+  std::size_t pos() const { return m_pos; }
+
+ private:
+  const char* m_data;
+  std::size_t m_size;
+  std::size_t m_pos;
+};
+
+// A read-only streambuf over memory, for buffers that need transcoding.
+class BufferStreamBuf : public std::streambuf {
+ public:
+  BufferStreamBuf(const char* data, std::size_t size) {
+    char* p = const_cast<char*>(data);
+    setg(p, p, p + size);
+  }
+};
+}  // namespace
+
 Stream::Stream(std::istream& input)
-    : m_input(input),
+    : m_pOwnedBuf{},
+      m_pOwnedInput{},
+      m_pInput(&input),
       m_mark{},
+      m_pBuffer(nullptr),
+      m_pBufferEnd(nullptr),
       m_charSet{},
       m_readahead{},
       m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]),
       m_nPrefetchedAvailable(0),
       m_nPrefetchedUsed(0) {
-  using char_traits = std::istream::traits_type;
-
   if (!input)
     return;
 
-  // Determine (or guess) the character-set by reading the BOM, if any.  See
-  // the YAML specification for the determination algorithm.
-  char_traits::int_type intro[4]{};
+  IntroStreamSource source(input);
+  DetectCharSet(source);
+  ReadAheadTo(0);
+}
+
+Stream::Stream(const char* data, std::size_t size)
+    : m_pOwnedBuf{},
+      m_pOwnedInput{},
+      m_pInput(nullptr),
+      m_mark{},
+      m_pBuffer(nullptr),
+      m_pBufferEnd(nullptr),
+      m_charSet{},
+      m_readahead{},
+      m_pPrefetched(nullptr),
+      m_nPrefetchedAvailable(0),
+      m_nPrefetchedUsed(0) {
+  if (!data) {
+    data = "";
+    size = 0;
+  }
+
+  IntroBufferSource source(data, size);
+  DetectCharSet(source);
+
+  if (m_charSet == utf8) {
+    m_pBuffer = data + source.pos();
+    m_pBufferEnd = data + size;
+    return;
+  }
+
+  m_pOwnedBuf.reset(new BufferStreamBuf(data + source.pos(), size - source.pos()));
+  m_pOwnedInput.reset(new std::istream(m_pOwnedBuf.get()));
+  m_pInput = m_pOwnedInput.get();
+  m_pPrefetched = new unsigned char[YAML_PREFETCH_SIZE];
+  ReadAheadTo(0);
+}
+
+// Determines (or guesses) the character-set by reading the BOM, if any.  See
+// the YAML specification for the determination algorithm.
+template <typename Source>
+void Stream::DetectCharSet(Source& source) {
+  std::istream::int_type intro[4]{};
   int nIntroUsed = 0;
   UtfIntroState state = uis_start;
   for (; !s_introFinalState[state];) {
-    std::istream::int_type ch = input.get();
+    std::istream::int_type ch = source.get();
     intro[nIntroUsed++] = ch;
     UtfIntroCharType charType = IntroCharTypeOf(ch);
     UtfIntroState newState = s_introTransitions[state][charType];
     int nUngets = s_introUngetCount[state][charType];
-    if (nUngets > 0) {
-      input.clear();
-      for (; nUngets > 0; --nUngets) {
-        if (char_traits::eof() != intro[--nIntroUsed])
-          input.putback(char_traits::to_char_type(intro[nIntroUsed]));
-      }
-    }
+    for (; nUngets > 0; --nUngets)
+      source.unget(intro[--nIntroUsed]);
     state = newState;
   }
 
@@ -236,30 +323,30 @@ Stream::Stream(std::istream& input)
       m_charSet = utf8;
       break;
   }
-
-  ReadAheadTo(0);
 }
 
 Stream::~Stream() { delete[] m_pPrefetched; }
 
-char Stream::peek() const {
-  if (m_readahead.empty()) {
-    return Stream::eof();
-  }
-
-  return m_readahead[0];
-}
-
 Stream::operator bool() const {
-  return m_input.good() ||
+  if (m_pBuffer)
+    return m_pBuffer < m_pBufferEnd;
+  return m_pInput->good() ||
          (!m_readahead.empty() && m_readahead[0] != Stream::eof());
 }
 
 // get
 // . Extracts a character from the stream and updates our position
 char Stream::get() {
-  char ch = peek();
-  AdvanceCurrent();
+  char ch;
+  if (m_pBuffer) {
+    ch = Stream::eof();
+    if (m_pBuffer < m_pBufferEnd)
+      ch = *m_pBuffer++;
+    m_mark.pos++;
+  } else {
+    ch = peek();
+    AdvanceCurrent();
+  }
   m_mark.column++;
 
   if (ch == '\n') {
@@ -274,7 +361,10 @@ char Stream::get() {
 // . Extracts 'n' characters from the stream and updates our position
 std::string Stream::get(int n) {
   std::string ret;
-  if (n > 0) {
+  if (m_pBuffer && n > 0 && n <= m_pBufferEnd - m_pBuffer) {
+    ret.assign(m_pBuffer, static_cast<std::size_t>(n));
+    eat(n);
+  } else if (n > 0) {
     ret.reserve(static_cast<std::string::size_type>(n));
     for (int i = 0; i < n; i++)
       ret += get();
@@ -290,6 +380,13 @@ void Stream::eat(int n) {
 }
 
 void Stream::AdvanceCurrent() {
+  if (m_pBuffer) {
+    if (m_pBuffer < m_pBufferEnd)
+      ++m_pBuffer;
+    m_mark.pos++;
+    return;
+  }
+
   if (!m_readahead.empty()) {
     m_readahead.pop_front();
     m_mark.pos++;
@@ -299,7 +396,7 @@ void Stream::AdvanceCurrent() {
 }
 
 bool Stream::_ReadAheadTo(size_t i) const {
-  while (m_input.good() && (m_readahead.size() <= i)) {
+  while (m_pInput->good() && (m_readahead.size() <= i)) {
     switch (m_charSet) {
       case utf8:
         StreamInUtf8();
@@ -320,7 +417,7 @@ bool Stream::_ReadAheadTo(size_t i) const {
   }
 
   // signal end of stream
-  if (!m_input.good())
+  if (!m_pInput->good())
     m_readahead.push_back(Stream::eof());
 
   return m_readahead.size() > i;
@@ -328,7 +425,7 @@ bool Stream::_ReadAheadTo(size_t i) const {
 
 void Stream::StreamInUtf8() const {
   unsigned char b = GetNextByte();
-  if (m_input.good()) {
+  if (m_pInput->good()) {
     m_readahead.push_back(static_cast<char>(b));
   }
 }
@@ -340,7 +437,7 @@ void Stream::StreamInUtf16() const {
 
   bytes[0] = GetNextByte();
   bytes[1] = GetNextByte();
-  if (!m_input.good()) {
+  if (!m_pInput->good()) {
     return;
   }
   ch = (static_cast<unsigned long>(bytes[nBigEnd]) << 8) |
@@ -361,7 +458,7 @@ void Stream::StreamInUtf16() const {
     for (;;) {
       bytes[0] = GetNextByte();
       bytes[1] = GetNextByte();
-      if (!m_input.good()) {
+      if (!m_pInput->good()) {
         QueueUnicodeCodepoint(m_readahead, CP_REPLACEMENT_CHARACTER);
         return;
       }
@@ -405,12 +502,12 @@ inline char* ReadBuffer(unsigned char* pBuffer) {
 
 unsigned char Stream::GetNextByte() const {
   if (m_nPrefetchedUsed >= m_nPrefetchedAvailable) {
-    std::streambuf* pBuf = m_input.rdbuf();
+    std::streambuf* pBuf = m_pInput->rdbuf();
     m_nPrefetchedAvailable = static_cast<std::size_t>(
         pBuf->sgetn(ReadBuffer(m_pPrefetched), YAML_PREFETCH_SIZE));
     m_nPrefetchedUsed = 0;
     if (!m_nPrefetchedAvailable) {
-      m_input.setstate(std::ios_base::eofbit);
+      m_pInput->setstate(std::ios_base::eofbit);
     }
 
     if (0 == m_nPrefetchedAvailable) {
@@ -432,7 +529,7 @@ void Stream::StreamInUtf32() const {
   bytes[1] = GetNextByte();
   bytes[2] = GetNextByte();
   bytes[3] = GetNextByte();
-  if (!m_input.good()) {
+  if (!m_pInput->good()) {
     return;
   }
 
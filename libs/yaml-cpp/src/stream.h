@@ -12,6 +12,7 @@
 #include <deque>
 #include <ios>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -24,6 +25,9 @@ class Stream {
   friend class StreamCharSource;
 
   Stream(std::istream& input);
+  // Reads directly from [data, data + size), which must outlive the stream.
+  // UTF-16/32 input is decoded through the istream path instead.
+  Stream(const char* data, std::size_t size);
   Stream(const Stream&) = delete;
   Stream(Stream&&) = delete;
   Stream& operator=(const Stream&) = delete;
@@ -33,11 +37,29 @@ class Stream {
   operator bool() const;
   bool operator!() const { return !static_cast<bool>(*this); }
 
-  char peek() const;
+  char peek() const {
+    if (m_pBuffer)
+      return m_pBuffer < m_pBufferEnd ? *m_pBuffer : Stream::eof();
+    return m_readahead.empty() ? Stream::eof() : m_readahead[0];
+  }
+  // the character i places ahead, or eof() past the end of the input
+  char peek(std::size_t i) const {
+    return ReadAheadTo(i) ? CharAt(i) : Stream::eof();
+  }
   char get();
   std::string get(int n);
   void eat(int n = 1);
 
+  // The unread bytes of a contiguous input; null when reading an istream.
+  const char* buffer() const { return m_pBuffer; }
+  const char* bufferEnd() const { return m_pBufferEnd; }
+  // eat() for n buffered characters that hold no line break
+  void eatInLine(std::size_t n) {
+    m_pBuffer += n;
+    m_mark.pos += static_cast<int>(n);
+    m_mark.column += static_cast<int>(n);
+  }
+
   static char eof() { return 0x04; }
 
   const Mark mark() const { return m_mark; }
@@ -49,15 +71,25 @@ class Stream {
  private:
   enum CharacterSet { utf8, utf16le, utf16be, utf32le, utf32be };
 
-  std::istream& m_input;
+  // Only set when a non-UTF-8 buffer is read through the istream path.
+  std::unique_ptr<std::streambuf> m_pOwnedBuf;
+  std::unique_ptr<std::istream> m_pOwnedInput;
+
+  std::istream* m_pInput;
   Mark m_mark;
 
+  // Contiguous UTF-8 input; when set, the readahead below is unused.
+  const char* m_pBuffer;
+  const char* m_pBufferEnd;
+
   CharacterSet m_charSet;
   mutable std::deque<char> m_readahead;
-  unsigned char* const m_pPrefetched;
+  unsigned char* m_pPrefetched;
   mutable size_t m_nPrefetchedAvailable;
   mutable size_t m_nPrefetchedUsed;
 
+  template <typename Source>
+  void DetectCharSet(Source& source);
   void AdvanceCurrent();
   char CharAt(size_t i) const;
   bool ReadAheadTo(size_t i) const;
@@ -69,11 +101,16 @@ class Stream {
 };
 
 // CharAt
-// . Unchecked access
-inline char Stream::CharAt(size_t i) const { return m_readahead[i]; }
+// . Unchecked access; a buffer reads as an endless run of eof() past its end
+inline char Stream::CharAt(size_t i) const {
+  if (m_pBuffer)
+    return i < static_cast<size_t>(m_pBufferEnd - m_pBuffer) ? m_pBuffer[i]
+                                                             : Stream::eof();
+  return m_readahead[i];
+}
 
 inline bool Stream::ReadAheadTo(size_t i) const {
-  if (m_readahead.size() > i)
+  if (m_pBuffer || m_readahead.size() > i)
     return true;
   return _ReadAheadTo(i);
 }
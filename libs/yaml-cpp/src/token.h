@@ -10,6 +10,7 @@
 #include "yaml-cpp/mark.h"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace YAML {
@@ -53,16 +54,18 @@ struct Token {
 
   friend std::ostream& operator<<(std::ostream& out, const Token& token) {
     out << TokenNames[token.type] << std::string(": ") << token.value;
-    for (const std::string& param : token.params)
+    for (std::string_view param : token.params)
       out << std::string(" ") << param;
     return out;
   }
 
+  // value and params view either the input or text kept by the TokenQueue,
+  // and are valid while the token is queued.
   STATUS status;
   TYPE type;
   Mark mark;
-  std::string value;
-  std::vector<std::string> params;
+  std::string_view value;
+  std::vector<std::string_view> params;
   int data;
 };
 }  // namespace YAML
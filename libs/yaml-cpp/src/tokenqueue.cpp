@@ -0,0 +1,82 @@
+#include "tokenqueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace YAML {
+namespace {
+const std::size_t kTokenBlockSize = 64;
+const std::size_t kTextBlockSize = 4096;
+}  // namespace
+
+TokenQueue::TokenQueue()
+    : m_blocks{},
+      m_head(0),
+      m_headPos(0),
+      m_tail(0),
+      m_size(0),
+      m_text{},
+      m_textBlock(0) {}
+
+TokenQueue::~TokenQueue() = default;
+
+void TokenQueue::push(Token token) {
+  if (m_blocks.empty()) {
+    m_blocks.emplace_back();
+    m_blocks.back().reserve(kTokenBlockSize);
+  } else if (m_blocks[m_tail].size() == kTokenBlockSize) {
+    std::size_t next = (m_tail + 1) % m_blocks.size();
+    if (next == m_head) {
+      // every block is in use, so open a new one after the tail; moving the
+      // others along keeps their tokens where they are
+      next = m_tail + 1;
+      m_blocks.emplace(m_blocks.begin() + static_cast<std::ptrdiff_t>(next));
+      m_blocks[next].reserve(kTokenBlockSize);
+      if (m_head >= next)
+        m_head++;
+    }
+    m_tail = next;
+  }
+
+  m_blocks[m_tail].push_back(std::move(token));
+  m_size++;
+}
+
+void TokenQueue::pop() {
+  m_size--;
+  if (++m_headPos < m_blocks[m_head].size())
+    return;
+
+  m_blocks[m_head].clear();
+  m_headPos = 0;
+  if (m_head != m_tail) {
+    m_head = (m_head + 1) % m_blocks.size();
+    return;
+  }
+
+  // empty: no token refers to the kept text any more
+  for (std::size_t i = 0; i <= m_textBlock && i < m_text.size(); i++)
+    m_text[i].used = 0;
+  m_textBlock = 0;
+}
+
+std::string_view TokenQueue::Keep(std::string_view text) {
+  if (text.empty())
+    return {};
+
+  while (m_textBlock < m_text.size() &&
+         m_text[m_textBlock].capacity - m_text[m_textBlock].used < text.size())
+    m_textBlock++;
+  if (m_textBlock == m_text.size()) {
+    std::size_t capacity = std::max(kTextBlockSize, text.size());
+    m_text.push_back(TextBlock{std::unique_ptr<char[]>(new char[capacity]),
+                               capacity, 0});
+  }
+
+  TextBlock& block = m_text[m_textBlock];
+  char* kept = block.data.get() + block.used;
+  std::memcpy(kept, text.data(), text.size());
+  block.used += text.size();
+  return {kept, text.size()};
+}
+}  // namespace YAML
@@ -0,0 +1,62 @@
+#ifndef TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) ||                                            \
+    (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || \
+     (__GNUC__ >= 4))  // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "token.h"
+
+namespace YAML {
+/**
+ * The scanner's FIFO of tokens.
+ *
+ * Tokens live in a ring of fixed-size blocks that are recycled once drained,
+ * so a queued token never moves (simple keys and indent markers point at
+ * them) and a steady-state scan does not allocate. Token text that cannot
+ * view the input is copied in with {@link #Keep}; that storage is rewound
+ * whenever the queue runs empty.
+ */
+class TokenQueue {
+ public:
+  TokenQueue();
+  TokenQueue(const TokenQueue&) = delete;
+  TokenQueue& operator=(const TokenQueue&) = delete;
+  ~TokenQueue();
+
+  bool empty() const { return m_size == 0; }
+  Token& front() { return m_blocks[m_head][m_headPos]; }
+  const Token& front() const { return m_blocks[m_head][m_headPos]; }
+  Token& back() { return m_blocks[m_tail].back(); }
+
+  void push(Token token);
+  void pop();
+
+  /** Copies text into storage that lasts until the queue next runs empty. */
+  std::string_view Keep(std::string_view text);
+
+ private:
+  struct TextBlock {
+    std::unique_ptr<char[]> data;
+    std::size_t capacity;
+    std::size_t used;
+  };
+
+  // queued tokens run from m_blocks[m_head][m_headPos] to m_blocks[m_tail]
+  std::vector<std::vector<Token>> m_blocks;
+  std::size_t m_head, m_headPos, m_tail;
+  std::size_t m_size;
+
+  std::vector<TextBlock> m_text;
+  std::size_t m_textBlock;
+};
+}  // namespace YAML
+
+#endif  // TOKENQUEUE_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -3,6 +3,7 @@
 #include "ofxConfigBridgeRegistry.hpp"
 #include "ofxConfigBridgeConverter.hpp"
 #include "ofxConfigBridgeDocument.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
 #include <type_traits>
 #include <string>
 
@@ -33,26 +34,65 @@ template<> struct DomFormat<toml::value> {
 };
 
 namespace detail {
-    inline void set_doc(Document& d, nlohmann::json v){
-        d.type = Document::Type::Json;
-        d.dom = nlohmann::ordered_json(std::move(v));
-    }
+    inline void set_doc(Document& d, nlohmann::json v){ d.type = Document::Type::Json;        d.dom = std::move(v); }
     inline void set_doc(Document& d, nlohmann::ordered_json v){ d.type = Document::Type::Json; d.dom = std::move(v); }
     inline void set_doc(Document& d, YAML::Node v){ d.type = Document::Type::Yaml;            d.dom = std::move(v); }
     inline void set_doc(Document& d, toml::ordered_value v){ d.type = Document::Type::Toml;           d.dom = std::move(v); }
-    inline void set_doc(Document& d, const toml::value& v) {
-        toml::ordered_value ordered_v = v;
-        d.type = Document::Type::Toml;
-        d.dom = std::move(ordered_v);
+    inline void set_doc(Document& d, toml::value v){ d.type = Document::Type::Toml;           d.dom = std::move(v); }
+
+    inline const nlohmann::ordered_json& get_oj   (const Document& d){ return d.ojson(); }
+    inline const YAML::Node&             get_yaml (const Document& d){ return d.yaml(); }
+    inline const toml::ordered_value&    get_toml (const Document& d){ return d.toml(); }
+
+    inline nlohmann::ordered_json&       get_oj   (Document& d){ return d.ojson(); }
+    inline YAML::Node&                   get_yaml (Document& d){ return d.yaml(); }
+    inline toml::ordered_value&          get_toml (Document& d){ return d.toml(); }
+
+    // Borrows the DOM without copying.
+    template<class Dom>
+    inline Document make_doc(const Dom& in){
+        return Document::borrow(in);
     }
 
-    inline const nlohmann::ordered_json& get_oj   (const Document& d){ return std::get<nlohmann::ordered_json>(d.dom); }
-    inline const YAML::Node&             get_yaml (const Document& d){ return std::get<YAML::Node>(d.dom); }
-    inline const toml::ordered_value&    get_toml (const Document& d){ return std::get<toml::ordered_value>(d.dom); }
+    // Moves the DOM out of a Document, re-encoding only when it holds the other
+    // ordering of the same format. Returns false if the document holds another format.
+    template<class Dom, class Other>
+    inline void take_either(Document& d, Dom& out){
+        if (d.holds<Dom>()) out = d.take<Dom>();
+        else                out = Dom(d.take<Other>());
+    }
+    template<class Dom>
+    inline bool take_doc(Document& d, Dom& out){
+        if constexpr (std::is_same_v<Dom, nlohmann::json>) {
+            if (d.type != Document::Type::Json) return false;
+            take_either<Document::UJsonDom, Document::JsonDom>(d, out);
+        } else if constexpr (std::is_same_v<Dom, nlohmann::ordered_json>) {
+            if (d.type != Document::Type::Json) return false;
+            take_either<Document::JsonDom, Document::UJsonDom>(d, out);
+        } else if constexpr (std::is_same_v<Dom, YAML::Node>) {
+            if (d.type != Document::Type::Yaml) return false;
+            out = d.take<Document::YamlDom>();
+        } else if constexpr (std::is_same_v<Dom, toml::ordered_value>) {
+            if (d.type != Document::Type::Toml) return false;
+            take_either<Document::TomlDom, Document::UTomlDom>(d, out);
+        } else if constexpr (std::is_same_v<Dom, toml::value>) {
+            if (d.type != Document::Type::Toml) return false;
+            take_either<Document::UTomlDom, Document::TomlDom>(d, out);
+        } else {
+            static_assert(sizeof(Dom)==0, "Unsupported Dom type");
+        }
+        return true;
+    }
 
-    inline nlohmann::ordered_json&       get_oj   (Document& d){ return std::get<nlohmann::ordered_json>(d.dom); }
-    inline YAML::Node&                   get_yaml (Document& d){ return std::get<YAML::Node>(d.dom); }
-    inline toml::ordered_value&          get_toml (Document& d){ return std::get<toml::ordered_value>(d.dom); }
+    // Document type a file of format `f` parses into; Type::None for formats without an adapter.
+    inline Document::Type doc_type_of(Format f){
+        switch (f) {
+            case Format::Json: case Format::OrderedJson: return Document::Type::Json;
+            case Format::Yaml:                           return Document::Type::Yaml;
+            case Format::Toml: case Format::OrderedToml: return Document::Type::Toml;
+            default:                                     return Document::Type::None;
+        }
+    }
 }
 
 template<class Dom>
@@ -62,33 +102,22 @@ inline ofx::configbridge::Result loadFile(const std::string& path, Dom& out) {
     if (!ad) return {false, "no adapter for requested format"};
 	auto filepath = ofToDataPath(path);
     Document doc;
-    auto r = ad->loadFile(filepath, doc);
+    // A file whose extension names another format is read into Dom directly.
+    const Format src = guess_format(filepath);
+    const auto src_type = detail::doc_type_of(src);
+    auto r = src_type != Document::Type::None && src_type != DomFormat<Dom>::doc_type
+           ? Converter::instance().loadFile(filepath, src, fmt, doc, {})
+           : ad->loadFile(filepath, doc);
     if (!r) return r;
 
     if constexpr (std::is_same_v<Dom, nlohmann::json>) {
-        if (doc.type == Document::Type::Json) {
-            out = detail::get_oj(doc);
-        } else {
-            return Result{false, "loaded document is not JSON"};
-        }
+        if (!detail::take_doc(doc, out)) return Result{false, "loaded document is not JSON"};
     } else if constexpr (std::is_same_v<Dom, nlohmann::ordered_json>) {
-        if (doc.type == Document::Type::Json) {
-            out = detail::get_oj(doc);
-        } else {
-            return Result{false, "loaded document is not JSON(ordered)"};
-        }
+        if (!detail::take_doc(doc, out)) return Result{false, "loaded document is not JSON(ordered)"};
     } else if constexpr (std::is_same_v<Dom, YAML::Node>) {
-        if (doc.type != Document::Type::Yaml) return Result{false, "loaded document is not YAML"};
-        out = detail::get_yaml(doc);
-    } else if constexpr (std::is_same_v<Dom, toml::ordered_value>) {
-        if (doc.type != Document::Type::Toml) return Result{false, "loaded document is not TOML"};
-        out = detail::get_toml(doc);
-    } else if constexpr (std::is_same_v<Dom, toml::value>) {
-        if (doc.type != Document::Type::Toml) return Result{false, "loaded document is not TOML"};
-        auto ordered_v = detail::get_toml(doc);
-        out = toml::value(ordered_v);
+        if (!detail::take_doc(doc, out)) return Result{false, "loaded document is not YAML"};
     } else {
-        static_assert(sizeof(Dom)==0, "Unsupported Dom type");
+        if (!detail::take_doc(doc, out)) return Result{false, "loaded document is not TOML"};
     }
     return {};
 }
@@ -101,26 +130,77 @@ inline Dom loadFile(const std::string& path) {
     return out;
 }
 
+namespace detail {
+    template<class Dom>
+    inline Result save_doc(const std::string& path, const Document& doc, const Options& opt) {
+        constexpr Format fmt = DomFormat<Dom>::value;
+        auto* ad = Registry::instance().find(fmt);
+        if (!ad) return {false, "no adapter for requested format"};
+        auto filepath = ofToDataPath(path);
+        return ad->saveFile(doc, filepath, opt);
+    }
+    template<class Dom>
+    inline Result dump_doc(const Document& doc, std::string& outText, const Options& opt) {
+        constexpr Format fmt = DomFormat<Dom>::value;
+        auto* ad = Registry::instance().find(fmt);
+        if (!ad) return {false, "no adapter for requested format"};
+        return ad->dumpText(doc, outText, opt);
+    }
+    template<class Dom>
+    inline Result dump_doc(const Document& doc, IOutputSink& out, const Options& opt) {
+        constexpr Format fmt = DomFormat<Dom>::value;
+        auto* ad = Registry::instance().find(fmt);
+        if (!ad) return {false, "no adapter for requested format"};
+        return ad->dump(doc, out, opt);
+    }
+    template<class To>
+    inline Result convert_doc(const Document& inDoc, To& out, const Options& opt) {
+        constexpr Format toFmt   = DomFormat<To>::value;
+        Document outDoc;
+        auto res = Converter::instance().convert(inDoc, toFmt, outDoc, opt);
+        if (!res) return res;
+
+        if constexpr (std::is_same_v<To, nlohmann::json> || std::is_same_v<To, nlohmann::ordered_json>) {
+            if (!take_doc(outDoc, out)) return Result{false, "converted doc is not JSON"};
+        } else if constexpr (std::is_same_v<To, YAML::Node>) {
+            if (!take_doc(outDoc, out)) return Result{false, "converted doc is not YAML"};
+        } else {
+            if (!take_doc(outDoc, out)) return Result{false, "converted doc is not TOML"};
+        }
+        return {};
+    }
+}
+
 template<class Dom>
 inline Result saveFile(const std::string& path, const Dom& in, const Options& opt = {}) {
-    constexpr Format fmt = DomFormat<Dom>::value;
-    auto* ad = Registry::instance().find(fmt);
-    if (!ad) return {false, "no adapter for requested format"};
-
-	auto filepath = ofToDataPath(path);
-    Document doc;
-    detail::set_doc(doc, Dom(in));
-    return ad->saveFile(doc, filepath, opt);
+    return detail::save_doc<Dom>(path, detail::make_doc(in), opt);
 }
 
 template<class Dom>
 inline Result dumpText(const Dom& in, std::string& outText, const Options& opt = {}) {
-    constexpr Format fmt = DomFormat<Dom>::value;
-    auto* ad = Registry::instance().find(fmt);
-    if (!ad) return {false, "no adapter for requested format"};
-    Document doc;
-    detail::set_doc(doc, Dom(in));
-    return ad->dumpText(doc, outText, opt);
+    return detail::dump_doc<Dom>(detail::make_doc(in), outText, opt);
+}
+
+// Appends to an ofBuffer.
+class BufferSink final : public IOutputSink {
+public:
+    explicit BufferSink(ofBuffer& buffer) : buffer_(buffer) {}
+    using IOutputSink::write;
+    void write(const char* data, std::size_t size) override { buffer_.append(data, size); }
+
+private:
+    ofBuffer& buffer_;
+};
+
+// Streams the text to `out` without building it as one string.
+template<class Dom>
+inline Result dump(const Dom& in, IOutputSink& out, const Options& opt = {}) {
+    return detail::dump_doc<Dom>(detail::make_doc(in), out, opt);
+}
+template<class Dom>
+inline Result dump(const Dom& in, ofBuffer& out, const Options& opt = {}) {
+    BufferSink sink(out);
+    return detail::dump_doc<Dom>(detail::make_doc(in), sink, opt);
 }
 
 template<class Dom>
@@ -132,45 +212,18 @@ inline Result parseText(const std::string& text, Dom& out) {
     auto r = ad->parseText(text, doc);
     if (!r) return r;
     if constexpr (std::is_same_v<Dom, nlohmann::json> || std::is_same_v<Dom, nlohmann::ordered_json>) {
-		if (doc.type != Document::Type::Json) return Result{false, "parsed doc is not JSON"};
-		out = detail::get_oj(doc);
+		if (!detail::take_doc(doc, out)) return Result{false, "parsed doc is not JSON"};
     } else if constexpr (std::is_same_v<Dom, YAML::Node>) {
-        if (doc.type != Document::Type::Yaml) return Result{false, "parsed doc is not YAML"};
-        out = detail::get_yaml(doc);
-    } else if constexpr (std::is_same_v<Dom, toml::ordered_value>) {
-        if (doc.type != Document::Type::Toml) return Result{false, "parsed doc is not TOML"};
-        out = detail::get_toml(doc);
-    } else if constexpr (std::is_same_v<Dom, toml::value>) {
-        if (doc.type != Document::Type::Toml) return Result{false, "parsed doc is not TOML"};
-        auto ordered_v = detail::get_toml(doc);
-        out = toml::value(ordered_v);
+        if (!detail::take_doc(doc, out)) return Result{false, "parsed doc is not YAML"};
+    } else {
+        if (!detail::take_doc(doc, out)) return Result{false, "parsed doc is not TOML"};
     }
     return {};
 }
 
 template<class To, class From>
 inline Result convert(const From& in, To& out, const Options& opt = {}) {
-    constexpr Format toFmt   = DomFormat<To>::value;
-    Document inDoc, outDoc;
-    detail::set_doc(inDoc, From(in));
-    auto res = Converter::instance().convert(inDoc, toFmt, outDoc, opt);
-    if (!res) return res;
-
-    if constexpr (std::is_same_v<To, nlohmann::json> || std::is_same_v<To, nlohmann::ordered_json>) {
-		if (outDoc.type != Document::Type::Json) return Result{false, "converted doc is not JSON"};
-		out = detail::get_oj(outDoc);
-    } else if constexpr (std::is_same_v<To, YAML::Node>) {
-        if (outDoc.type != Document::Type::Yaml) return Result{false, "converted doc is not YAML"};
-        out = detail::get_yaml(outDoc);
-    } else if constexpr (std::is_same_v<To, toml::ordered_value>) {
-        if (outDoc.type != Document::Type::Toml) return Result{false, "converted doc is not TOML"};
-        out = detail::get_toml(outDoc);
-    } else if constexpr (std::is_same_v<To, toml::value>) {
-        if (outDoc.type != Document::Type::Toml) return Result{false, "converted doc is not TOML"};
-        auto ordered_v = detail::get_toml(outDoc);
-        out = toml::value(ordered_v);
-    }
-    return {};
+    return detail::convert_doc(detail::make_doc(in), out, opt);
 }
 
 template<class To, class From>
@@ -1,6 +1,7 @@
 #pragma once
 #include "ofxConfigBridgeFormat.hpp"
 #include "ofxConfigBridgeDocument.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
 #include <string>
 #include <string_view>
 
@@ -16,6 +17,8 @@ public:
     virtual Result loadFile (const std::string& path, Document& out) = 0;
 
     virtual Result dumpText (const Document& in, std::string& outText, const Options& opt) = 0;
+    // Streams the text to `out` as it is produced instead of building it whole.
+    virtual Result dump     (const Document& in, IOutputSink& out, const Options& opt) = 0;
     virtual Result saveFile (const Document& in, const std::string& path, const Options& opt) = 0;
 };
 
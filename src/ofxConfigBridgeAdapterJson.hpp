@@ -17,6 +17,7 @@ public:
     Result parseText(std::string_view text, Document& out) override;
     Result loadFile (const std::string& path, Document& out) override;
     Result dumpText (const Document& in, std::string& outText, const Options& opt) override;
+    Result dump     (const Document& in, IOutputSink& out, const Options& opt) override;
     Result saveFile (const Document& in, const std::string& path, const Options& opt) override;
 };
 
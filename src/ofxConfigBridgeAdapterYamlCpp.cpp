@@ -1,14 +1,15 @@
 #include "ofxConfigBridgeAdapterYamlCpp.hpp"
+#include "ofxConfigBridgeInputSource.hpp"
 #include "ofxConfigBridgeRegistry.hpp"
-#include <fstream>
-#include <sstream>
-#include <iomanip>
+#include "ofxConfigBridgeYamlScalar.hpp"
+#include <memory>
+#include <ostream>
 
 namespace ofx { namespace configbridge {
 
 Result AdapterYamlCpp::parseText(std::string_view text, Document& out){
     try{
-        Document::YamlDom node = YAML::Load(std::string(text));
+        Document::YamlDom node = YAML::Load(text.data(), text.size());
         out.type = Document::Type::Yaml;
         out.dom  = std::move(node);
         return {};
@@ -17,93 +18,45 @@ Result AdapterYamlCpp::parseText(std::string_view text, Document& out){
     }
 }
 Result AdapterYamlCpp::loadFile(const std::string& path, Document& out){
-    try{
-        Document::YamlDom node = YAML::LoadFile(path);
-        out.type = Document::Type::Yaml;
-        out.dom  = std::move(node);
-        return {};
-    }catch(const std::exception& e){
-        return Result{false, e.what()};
-    }
-}
-
-std::string formatFloatForYaml(double value, int precision) {
-    std::ostringstream ss;
-    ss << std::fixed << std::setprecision(precision) << value;
-    std::string result = ss.str();
-    
-    // Remove trailing zeros, but keep at least one decimal place
-    if (result.find('.') != std::string::npos) {
-        while (result.length() > 2 && result.back() == '0') {
-            result.pop_back();
-        }
-        // Ensure integers like 1 become 1.0 (keep at least one decimal place)
-        if (result.back() == '.') {
-            result += '0';
-        }
-    }
-    
-    return result;
-}
-
-YAML::Node applyPrecisionToYamlNode(const YAML::Node& node, int precision) {
-    YAML::Node result;
-    
-    switch (node.Type()) {
-        case YAML::NodeType::Scalar:
-            if (node.IsScalar()) {
-                try {
-                    // Try to convert to double
-                    double val = node.as<double>();
-                    result = formatFloatForYaml(val, precision);
-                } catch (...) {
-                    // Not a number, keep as is
-                    result = node;
-                }
-            }
-            break;
-            
-        case YAML::NodeType::Sequence:
-            for (std::size_t i = 0; i < node.size(); ++i) {
-                result[i] = applyPrecisionToYamlNode(node[i], precision);
-            }
-            break;
-            
-        case YAML::NodeType::Map:
-            for (const auto& pair : node) {
-                result[pair.first.as<std::string>()] = applyPrecisionToYamlNode(pair.second, precision);
-            }
-            break;
-            
-        default:
-            result = node;
-            break;
-    }
-    
-    return result;
+    InputSource src;
+    auto r = src.open(path); if(!r) return r;
+    return parseText(src.text(), out);
 }
 
 Result AdapterYamlCpp::dumpText(const Document& in, std::string& outText, const Options& opt){
     if (in.type != Document::Type::Yaml) return Result{false, "doc type mismatch(yaml)"};
-    const auto& node = std::get<Document::YamlDom>(in.dom);
-    
-    // Apply precision control to the entire YAML tree
-    YAML::Node processedNode = applyPrecisionToYamlNode(node, opt.float_precision);
+    const auto& node = in.yaml();
     
+    // float precision is applied to scalars as they are emitted
     YAML::Emitter emitter;
-    emitter << processedNode;
+    setYamlFloatPrecision(emitter, opt.float_precision);
+    emitter << node;
     
     if (!emitter.good()) return Result{false, "yaml emitter error"};
     outText = emitter.c_str();
     return {};
 }
-Result AdapterYamlCpp::saveFile(const Document& in, const std::string& path, const Options& opt){
-    std::string y; auto r = dumpText(in, y, opt); if(!r) return r;
-    std::ofstream ofs(path, std::ios::binary);
-    if(!ofs) return Result{false, "open yaml for write failed"};
-    ofs.write(y.data(), (std::streamsize)y.size());
+Result AdapterYamlCpp::dump(const Document& in, IOutputSink& out, const Options& opt){
+    if (in.type != Document::Type::Yaml) return Result{false, "doc type mismatch(yaml)"};
+    const auto& node = in.yaml();
+
+    SinkStreamBuf buffer(out);
+    std::ostream stream(&buffer);
+    YAML::Emitter emitter(stream);
+    setYamlFloatPrecision(emitter, opt.float_precision);
+    emitter << node;
+
+    if (!emitter.good()) return Result{false, "yaml emitter error"};
+    if (buffer.pubsync() != 0) return Result{false, "write yaml failed"};
     return {};
 }
+Result AdapterYamlCpp::saveFile(const Document& in, const std::string& path, const Options& opt){
+    if (in.type != Document::Type::Yaml) return Result{false, "doc type mismatch(yaml)"};
+    FileSink file;
+    auto r = file.open(path, opt); if(!r) return r;
+    r = dump(in, file, opt); if(!r) return r;
+    return file.commit();
+}
 
 // static auto-register
 static struct _YamlAutoReg {
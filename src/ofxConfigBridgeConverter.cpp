@@ -1,18 +1,21 @@
 #include "ofxConfigBridgeConverter.hpp"
 #include "ofxConfigBridgeAdapter.hpp"
+#include "ofxConfigBridgeInputSource.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
 #include "ofxConfigBridgeRegistry.hpp"
-#include <fstream>
-#include <sstream>
 
 namespace ofx { namespace configbridge {
 
 Converter& Converter::instance(){ static Converter c; return c; }
 
 void Converter::registerTextBridge(Format from, Format to, TextBridge fn){
-    text_[key(from,to)] = std::move(fn);
+    text_.set(from, to, std::move(fn));
 }
 void Converter::registerNativeBridge(Format from, Format to, NativeBridge fn){
-    native_[key(from,to)] = std::move(fn);
+    native_.set(from, to, std::move(fn));
+}
+void Converter::registerParseBridge(Format from, Format to, ParseBridge fn){
+    parse_.set(from, to, std::move(fn));
 }
 
 Result Converter::convert(const Document& in, Format to, Document& out, const Options& opt){
@@ -22,39 +25,64 @@ Result Converter::convert(const Document& in, Format to, Document& out, const Op
 		in.type==Document::Type::Toml ? Format::Toml :
         Format::Auto;
 
-    auto itN = native_.find(key(from, to));
-    if (itN != native_.end()) return itN->second(in, out, opt);
+    if (auto* fn = native_.find(from, to)) return (*fn)(in, out, opt);
 
     // If no native bridge is available, this conversion is not supported
     return Result{false, "direct format conversion not supported"};
 }
 
-Result Converter::convertText(Format from, Format to, const std::string& in, std::string& out, const Options& opt){
-    auto it = text_.find(key(from,to));
-    if (it == text_.end()) {
-        auto* aFrom = Registry::instance().find(from);
-        auto* aTo   = Registry::instance().find(to);
-        if (!aFrom || !aTo) return {false, "no adapter for bridge"};
-        Document d;
-        auto r1 = aFrom->parseText(in, d);
-        if (!r1) return r1;
-        return aTo->dumpText(d, out, opt);
-    }
-    return it->second(in, out, opt);
+Result Converter::parseText(Format from, Format to, std::string_view in, Document& out, const Options& opt){
+    if (auto* fn = parse_.find(from, to)) return (*fn)(in, out, opt);
+
+    auto* aFrom = Registry::instance().find(from);
+    if (!aFrom) return {false, "no adapter for bridge"};
+    if (normalize(from) == normalize(to)) return aFrom->parseText(in, out);
+    Document d;
+    auto r = aFrom->parseText(in, d);
+    if (!r) return r;
+    return convert(d, to, out, opt);
+}
+
+Result Converter::loadFile(const std::string& path, Format from, Format to, Document& out, const Options& opt){
+    InputSource src;
+    auto r = src.open(path);
+    if(!r) return r;
+    return parseText(from, to, src.text(), out, opt);
+}
+
+Result Converter::convertText(Format from, Format to, std::string_view in, IOutputSink& out, const Options& opt){
+    if (auto* fn = text_.find(from, to)) return (*fn)(in, out, opt);
+
+    auto* aFrom = Registry::instance().find(from);
+    auto* aTo   = Registry::instance().find(to);
+    if (!aFrom || !aTo) return {false, "no adapter for bridge"};
+    Document d;
+    auto r = aFrom->parseText(in, d);
+    if (!r) return r;
+    if (normalize(from) == normalize(to)) return aTo->dump(d, out, opt);
+    Document converted;
+    r = convert(d, to, converted, opt);
+    if (!r) return r;
+    return aTo->dump(converted, out, opt);
+}
+
+Result Converter::convertText(Format from, Format to, std::string_view in, std::string& out, const Options& opt){
+    out.clear();
+    StringSink sink(out);
+    return convertText(from, to, in, sink, opt);
 }
 
 Result Converter::convertFile(const std::string& inPath, Format inFmt,
                               const std::string& outPath, Format outFmt, const Options& opt){
-    std::ifstream ifs(inPath, std::ios::binary);
-    if(!ifs) return {false, "open input failed"};
-    std::ostringstream oss; oss<<ifs.rdbuf();
-    std::string in = oss.str(), out;
-    auto r = convertText(inFmt, outFmt, in, out, opt);
+    InputSource src;
+    auto r = src.open(inPath);
+    if(!r) return r;
+    FileSink file;
+    r = file.open(outPath, opt);
+    if(!r) return r;
+    r = convertText(inFmt, outFmt, src.text(), file, opt);
     if(!r) return r;
-    std::ofstream ofs(outPath, std::ios::binary);
-    if(!ofs) return {false, "open output failed"};
-    ofs.write(out.data(), (std::streamsize)out.size());
-    return {};
+    return file.commit();
 }
 
 }} // namespace ofx::configbridge
@@ -1,15 +1,21 @@
 #pragma once
 #include "ofxConfigBridgeFormat.hpp"
 #include "ofxConfigBridgeDocument.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
 #include "ofxConfigBridgeRegistry.hpp"
+#include <array>
 #include <functional>
-#include <unordered_map>
 #include <string>
+#include <string_view>
 
 namespace ofx { namespace configbridge {
 
-using TextBridge   = std::function<Result(const std::string& in, std::string& out, const Options& opt)>;
+// Text bridges convert text to text without building DOMs, writing the
+// result to `out` as they go.
+using TextBridge   = std::function<Result(std::string_view in, IOutputSink& out, const Options& opt)>;
 using NativeBridge = std::function<Result(const Document& inDoc, Document& outDoc, const Options& opt)>;
+// Parse bridges read text of one format straight into the DOM of another.
+using ParseBridge  = std::function<Result(std::string_view in, Document& outDoc, const Options& opt)>;
 
 class Converter {
 public:
@@ -17,28 +23,61 @@ public:
 
     void registerTextBridge(Format from, Format to, TextBridge fn);
     void registerNativeBridge(Format from, Format to, NativeBridge fn);
+    void registerParseBridge(Format from, Format to, ParseBridge fn);
 
     Result convert(const Document& in, Format to, Document& out, const Options& opt);
-    Result convertText(Format from, Format to, const std::string& in, std::string& out, const Options& opt);
+    // Reads `from` text into a `to` document. Uses a registered parse bridge
+    // if there is one; otherwise parses the text and converts the DOM.
+    Result parseText(Format from, Format to, std::string_view in, Document& out, const Options& opt);
+    Result loadFile(const std::string& path, Format from, Format to, Document& out, const Options& opt);
+    // Uses a registered text bridge if there is one; otherwise parses the
+    // text, converts the DOM and dumps it.
+    Result convertText(Format from, Format to, std::string_view in, IOutputSink& out, const Options& opt);
+    Result convertText(Format from, Format to, std::string_view in, std::string& out, const Options& opt);
+    // A failed conversion leaves an existing output file as it was.
     Result convertFile(const std::string& inPath, Format inFmt,
                        const std::string& outPath, Format outFmt, const Options& opt);
 
 private:
-    std::unordered_map<long long, TextBridge>   text_;
-    std::unordered_map<long long, NativeBridge> native_;
-    static long long key(Format a, Format b){
-        auto normalizeFormat = [](Format f) -> Format {
-            switch(f) {
-                case Format::OrderedJson: return Format::Json;
-                case Format::OrderedToml: return Format::Toml;
-                default: return f;
-            }
-        };
-        
-        Format normalizedA = normalizeFormat(a);
-        Format normalizedB = normalizeFormat(b);
-        return (long long)static_cast<int>(normalizedA)<<32 | (int)normalizedB;
+    static Format normalize(Format f){
+        switch(f) {
+            case Format::OrderedJson: return Format::Json;
+            case Format::OrderedToml: return Format::Toml;
+            default: return f;
+        }
     }
+    // Bridges by (from, to). Registration also resolves every pair to the
+    // exact bridge, so bridges can target a specific DOM ordering, or else
+    // the ordering-agnostic one; a lookup is then a single table read.
+    template<class Fn>
+    class BridgeTable {
+    public:
+        void set(Format a, Format b, Fn fn){
+            exact_[index(a)][index(b)] = std::move(fn);
+            for (std::size_t x = 0; x < kFormatCount; ++x) {
+                for (std::size_t y = 0; y < kFormatCount; ++y) {
+                    const Fn* f = &exact_[x][y];
+                    if (!*f) f = &exact_[index(normalize(Format(x)))][index(normalize(Format(y)))];
+                    resolved_[x][y] = *f ? f : nullptr;
+                }
+            }
+        }
+        const Fn* find(Format a, Format b) const {
+            const auto x = index(a), y = index(b);
+            return x < kFormatCount && y < kFormatCount ? resolved_[x][y] : nullptr;
+        }
+
+    private:
+        template<class T> using Matrix = std::array<std::array<T, kFormatCount>, kFormatCount>;
+        static std::size_t index(Format f){ return static_cast<std::size_t>(f); }
+
+        Matrix<Fn>        exact_;
+        Matrix<const Fn*> resolved_{};
+    };
+
+    BridgeTable<TextBridge>   text_;
+    BridgeTable<NativeBridge> native_;
+    BridgeTable<ParseBridge>  parse_;
 };
 
 }} // namespace ofx::configbridge
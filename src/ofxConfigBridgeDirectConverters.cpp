@@ -1,30 +1,27 @@
 #include "ofxConfigBridgeConverter.hpp"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include "ofxConfigBridgeObjectBuilder.hpp"
+#include "ofxConfigBridgeTomlWriter.hpp"
+#include "ofxConfigBridgeYamlScalar.hpp"
 #include "yaml.h"
 #include <nlohmann/json.hpp>
 #include "toml.hpp"
 #include <string>
-#include <sstream>
+#include <cmath>
 
 namespace {
-inline bool tag_is(const YAML::Node& n, const char* tag) {
-	try { return n.Tag() == tag; } catch (...) { return false; }
+// Same text as as<std::string>() for scalar and null keys, without throwing on others.
+inline std::string yaml_key(const YAML::Node& n){
+	if (n.IsScalar()) return n.Scalar();
+	if (n.IsNull())   return "null";
+	return std::string();
 }
-inline std::string scalar_of(const YAML::Node& n) {
-	try { return n.Scalar(); } catch (...) { return std::string(); }
-}
-inline bool is_null_token(const std::string& s){
-	return s == "~" || s == "null" || s == "Null" || s == "NULL";
-}
-inline static std::string format_float_preserving_decimal(double v, int float_precision){
-	std::ostringstream oss;
-	if (std::isfinite(v) && std::floor(v) == v){
-		oss.setf(std::ios::fixed);
-		oss << std::setprecision(1) << v;
-	} else {
-		int prec = (float_precision > 0 ? float_precision : 6);
-		oss << std::defaultfloat << std::setprecision(prec) << v;
-	}
-	return oss.str();
+// Finite floats keep a '.' or exponent so they stay floats in YAML; the
+// emitter applies Options::float_precision when the node is dumped.
+inline YAML::Node YamlFloatNode(YAML::NodeFactory& f, double v){
+	if (std::isnan(v)) return f.Scalar(".nan");
+	if (std::isinf(v)) return f.Scalar(v < 0 ? "-.inf" : ".inf");
+	return f.Scalar(ofx::configbridge::formatFloat(v, -1));
 }
 
 }
@@ -33,60 +30,63 @@ namespace ofx { namespace configbridge {
 template<class BasicJson>
 static BasicJson YamlScalarToJson(const YAML::Node& n) {
 	using J = BasicJson;
-
-	if (tag_is(n, "!!str")) return J(scalar_of(n));
-
-	try { return J(n.as<bool>()); } catch (...) {}
-	try { return J(n.as<long long>()); } catch (...) {}
-	try { return J(n.as<unsigned long long>()); } catch (...) {}
-	try { return J(n.as<double>()); } catch (...) {}
-
-	const auto s = scalar_of(n);
-	if (is_null_token(s)) return nullptr;
-
-	return J(s);
+	const auto r = resolveYamlScalar(n);
+	switch (r.kind) {
+		case YamlScalar::Kind::Null:  return nullptr;
+		case YamlScalar::Kind::Bool:  return J(r.b);
+		case YamlScalar::Kind::Int:   return J(r.i);
+		case YamlScalar::Kind::Uint:  return J(r.u);
+		case YamlScalar::Kind::Float: return J(r.f);
+		default:                      return J(n.Scalar());
+	}
 }
 
 
-static nlohmann::ordered_json YAMLNodeToOJson(const YAML::Node& n, const Options& /*opt*/){
-	using ojson = nlohmann::ordered_json;
-	if (n.IsMap()){ ojson o=ojson::object(); for(auto it=n.begin(); it!=n.end(); ++it) o[it->first.as<std::string>()]=YAMLNodeToOJson(it->second, {}); return o; }
-	if (n.IsSequence()){ ojson a=ojson::array(); for(auto it=n.begin(); it!=n.end(); ++it) a.push_back(YAMLNodeToOJson(*it, {})); return a; }
+template<class BasicJson>
+static BasicJson YAMLNodeToJson(const YAML::Node& n, const Options& /*opt*/){
+	using J = BasicJson;
+	if (n.IsMap()){
+		// YAML maps may repeat a key; the last value wins.
+		JsonObjectBuilder<J> o(n.size(), true);
+		for(auto it=n.begin(); it!=n.end(); ++it) o.add(yaml_key(it->first), YAMLNodeToJson<J>(it->second, {}));
+		return o.finish();
+	}
+	if (n.IsSequence()){
+		J a=J::array(); a.template get_ref<typename J::array_t&>().reserve(n.size());
+		for(auto it=n.begin(); it!=n.end(); ++it) a.push_back(YAMLNodeToJson<J>(*it, {}));
+		return a;
+	}
 	if (n.IsNull()) return nullptr;
-	return YamlScalarToJson<ojson>(n);
+	return YamlScalarToJson<J>(n);
 }
 
+// Keys of a JSON object are unique, so pairs are appended without a lookup.
 template<class BasicJson>
-static void JsonToYAMLNode(YAML::Node& node, const BasicJson& j, const Options& opt){
+static YAML::Node JsonToYAMLNode(YAML::NodeFactory& f, const BasicJson& j){
 	if (j.is_object()){
-		node = YAML::Node(YAML::NodeType::Map);
-		for (auto it=j.begin(); it!=j.end(); ++it){ YAML::Node c; JsonToYAMLNode(c, it.value(), opt); node[it.key()] = c; }
+		YAML::Node node = f.Map(j.size());
+		for (auto it=j.begin(); it!=j.end(); ++it) f.Append(node, f.Scalar(it.key()), JsonToYAMLNode(f, it.value()));
+		return node;
 	} else if (j.is_array()){
-		node = YAML::Node(YAML::NodeType::Sequence);
-		for (auto& v : j){ YAML::Node c; JsonToYAMLNode(c, v, opt); node.push_back(c); }
+		YAML::Node node = f.Sequence(j.size());
+		for (auto& v : j) f.Append(node, JsonToYAMLNode(f, v));
+		return node;
 	} else if (j.is_boolean()){
-		node = YAML::Node(j.template get<bool>());
-	} else if (j.is_number_integer()){
-		node = YAML::Node(j.template get<long long>());
+		return f.Scalar(j.template get<bool>() ? "true" : "false");
+	} else if (j.is_number_integer() && !j.is_number_unsigned()){
+		return f.Scalar(std::to_string(j.template get<long long>()));
 	} else if (j.is_number_unsigned()){
-		node = YAML::Node(j.template get<unsigned long long>());
+		return f.Scalar(std::to_string(j.template get<unsigned long long>()));
 	} else if (j.is_number_float()){
-		const double v = j.template get<double>();
-		if (std::isfinite(v) && std::floor(v) == v) {
-			std::string s = format_float_preserving_decimal(v, opt.float_precision);
-			node = YAML::Node(s);
-		} else {
-			node = YAML::Node(v);
-		}
+		return YamlFloatNode(f, j.template get<double>());
 	} else if (j.is_null()){
-		node = YAML::Node();
-	} else {
-		node = YAML::Node(j.template get<std::string>());
+		return f.Null();
 	}
+	return f.Scalar(j.template get_ref<const std::string&>());
 }
 
-template<class BasicJson>
-static BasicJson TomlValueToJson(const toml::ordered_value& v) {
+template<class BasicJson, class TomlValue>
+static BasicJson TomlValueToJson(const TomlValue& v) {
 	using J = BasicJson;
 
 	if (v.is_string())        return J(v.as_string());
@@ -94,217 +94,243 @@ static BasicJson TomlValueToJson(const toml::ordered_value& v) {
 	else if (v.is_floating()) return J(v.as_floating());
 	else if (v.is_boolean())  return J(v.as_boolean());
 	else if (v.is_array()) {
+		const auto& a = v.as_array();
 		J arr = J::array();
-		for (int i = 0; i < v.size(); ++i) {
-			arr.push_back(TomlValueToJson<J>(v.at(i)));
+		arr.template get_ref<typename J::array_t&>().reserve(a.size());
+		for (const auto& el : a) {
+			arr.push_back(TomlValueToJson<J>(el));
 		}
 		return arr;
 	}
 	else if (v.is_table()) {
-		J obj = J::object();
-		auto t = toml::get<toml::ordered_table>(v);
+		const auto& t = v.as_table();
+		JsonObjectBuilder<J> obj(t.size());
 		for(const auto &[key, value] : t) {
-			obj[key] = TomlValueToJson<J>(value);
+			obj.add(key, TomlValueToJson<J>(value));
 		}
-		return obj;
+		return obj.finish();
 	}
 	else if (v.is_local_date() || v.is_local_time()
 		  || v.is_local_datetime() || v.is_offset_datetime()) {
-		return J(toml::format(v));
+		std::string text;
+		appendTomlDateTime(text, v);
+		return J(std::move(text));
 	}
 	return J(nullptr);
 }
 
-template<class BasicJson>
-static void JsonToTomlValue(toml::ordered_table& table, const std::string& key, const BasicJson& json) {
-	if (json.is_null()) {
-		table[key] = toml::ordered_value("");
-	} else if (json.is_boolean()) {
-		table[key] = toml::ordered_value(json.template get<bool>());
-	} else if (json.is_number_integer()) {
-		table[key] = toml::ordered_value((std::int64_t)json.template get<std::int64_t>());
+template<class TomlValue, class BasicJson>
+static TomlValue JsonToTomlValue(const BasicJson& json) {
+	if (json.is_boolean()) {
+		return TomlValue(json.template get<bool>());
+	} else if (json.is_number_integer() && !json.is_number_unsigned()) {
+		return TomlValue((std::int64_t)json.template get<std::int64_t>());
 	} else if (json.is_number_unsigned()) {
 		const auto u = json.template get<std::uint64_t>();
 		if (u <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
-			table[key] = toml::ordered_value((std::int64_t)u);
-		else
-			table[key] = toml::ordered_value((double)u);
+			return TomlValue((std::int64_t)u);
+		return TomlValue((double)u);
 	} else if (json.is_number_float()) {
-		table[key] = toml::ordered_value(json.template get<double>());
+		return TomlValue(json.template get<double>());
 	} else if (json.is_string()) {
-		table[key] = toml::ordered_value(json.template get<std::string>());
+		return TomlValue(json.template get_ref<const std::string&>());
 	} else if (json.is_array()) {
-		toml::array arr;
-		for (const auto& item : json) {
-			if (item.is_string())               arr.push_back(toml::ordered_value(item.template get<std::string>()));
-			else if (item.is_number_integer())  arr.push_back(toml::ordered_value((std::int64_t)item.template get<std::int64_t>()));
-			else if (item.is_number_unsigned()) {
-				const auto u2 = item.template get<std::uint64_t>();
-				if (u2 <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
-					arr.push_back(toml::ordered_value((std::int64_t)u2));
-				else
-					arr.push_back(toml::ordered_value((double)u2));
-			}
-			else if (item.is_number_float())    arr.push_back(toml::ordered_value(item.template get<double>()));
-			else if (item.is_boolean())         arr.push_back(toml::ordered_value(item.template get<bool>()));
-			else if (item.is_object()) {
-				toml::ordered_table nested;
-				for (const auto& [nk, nv] : item.items())
-					JsonToTomlValue(nested, nk, nv);
-				arr.push_back(toml::ordered_value(nested));
-			} else if (item.is_array()) {
-				toml::array arr2;
-				for (const auto& sub : item) {
-					if (sub.is_string())               arr2.push_back(toml::ordered_value(sub.template get<std::string>()));
-					else if (sub.is_number_integer())  arr2.push_back(toml::ordered_value((std::int64_t)sub.template get<std::int64_t>()));
-					else if (sub.is_number_unsigned()) {
-						const auto u3 = sub.template get<std::uint64_t>();
-						if (u3 <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
-							arr2.push_back(toml::ordered_value((std::int64_t)u3));
-						else
-							arr2.push_back(toml::ordered_value((double)u3));
-					}
-					else if (sub.is_number_float())    arr2.push_back(toml::ordered_value(sub.template get<double>()));
-					else if (sub.is_boolean())         arr2.push_back(toml::ordered_value(sub.template get<bool>()));
-				}
-				arr.push_back(toml::ordered_value(arr2));
-			}
-		}
-		table[key] = toml::ordered_value(arr);
+		typename TomlValue::array_type arr;
+		arr.reserve(json.size());
+		for (const auto& item : json)
+			arr.push_back(JsonToTomlValue<TomlValue>(item));
+		return TomlValue(std::move(arr));
 	} else if (json.is_object()) {
-		toml::ordered_table nested;
-		for (const auto& [nk, nv] : json.items())
-			JsonToTomlValue(nested, nk, nv);
-		table[key] = toml::ordered_value(nested);
-	} else {
-		table[key] = toml::ordered_value("");
+		TomlTableBuilder<TomlValue> table(json.size());
+		for (auto it = json.begin(); it != json.end(); ++it)
+			table.add(it.key(), JsonToTomlValue<TomlValue>(it.value()));
+		return table.finish();
 	}
+	return TomlValue(""); // null
 }
 
-template<class BasicJson>
-static void JsonToTomlTable(toml::ordered_table& table, const BasicJson& json, const Options& /*opt*/) {
-	for (const auto& [key, value] : json.items())
-		JsonToTomlValue(table, key, value);
-}
-
-static YAML::Node TomlValueToYaml(const toml::ordered_value& v) {
-	YAML::Node y;
-	if (v.is_string())            y = YAML::Node(toml::get<std::string>(v));
-	else if (v.is_integer())      y = YAML::Node((long long)toml::get<std::int64_t>(v));
-	else if (v.is_floating())     y = YAML::Node((double)toml::get<double>(v));
-	else if (v.is_boolean())      y = YAML::Node(toml::get<bool>(v));
+template<class TomlValue>
+static YAML::Node TomlValueToYaml(YAML::NodeFactory& f, const TomlValue& v) {
+	if (v.is_string())            return f.Scalar(v.as_string());
+	else if (v.is_integer())      return f.Scalar(std::to_string(v.as_integer()));
+	else if (v.is_floating())     return YamlFloatNode(f, v.as_floating());
+	else if (v.is_boolean())      return f.Scalar(v.as_boolean() ? "true" : "false");
 	else if (v.is_array()) {
-		y = YAML::Node(YAML::NodeType::Sequence);
-		for (const auto& el : toml::get<toml::array>(v))
-			y.push_back(TomlValueToYaml(el));
+		const auto& a = v.as_array();
+		YAML::Node y = f.Sequence(a.size());
+		for (const auto& el : a)
+			f.Append(y, TomlValueToYaml(f, el));
+		return y;
 	}
 	else if (v.is_table()) {
-		y = YAML::Node(YAML::NodeType::Map);
-		for (const auto& kv : toml::get<toml::ordered_table>(v))
-			y[kv.first] = TomlValueToYaml(kv.second);
+		// TOML tables cannot hold duplicate keys.
+		const auto& t = v.as_table();
+		YAML::Node y = f.Map(t.size());
+		for (const auto& kv : t)
+			f.Append(y, f.Scalar(kv.first), TomlValueToYaml(f, kv.second));
+		return y;
 	}
 	else if (v.is_local_date() || v.is_local_time()
 		  || v.is_local_datetime() || v.is_offset_datetime()) {
-		y = YAML::Node(toml::format(v));
+		std::string text;
+		appendTomlDateTime(text, v);
+		return f.Scalar(text);
 	}
-	else y = YAML::Node(); // null
-	return y;
+	return f.Null();
 }
 
-static toml::ordered_value YamlNodeToToml(const YAML::Node& n) {
+template<class TomlValue>
+static TomlValue YamlNodeToToml(const YAML::Node& n) {
 	if (n.IsMap()) {
-		toml::ordered_table table;
+		// YAML maps may repeat a key; the last value wins.
+		TomlTableBuilder<TomlValue> table(n.size(), true);
 		for (auto it = n.begin(); it != n.end(); ++it) {
-			const std::string key = it->first.as<std::string>();
-			table[key] = YamlNodeToToml(it->second);
+			table.add(yaml_key(it->first), YamlNodeToToml<TomlValue>(it->second));
 		}
-		return toml::ordered_value(table);
+		return table.finish();
 	}
 	else if (n.IsSequence()) {
-		toml::array arr;
+		typename TomlValue::array_type arr;
+		arr.reserve(n.size());
 		for (auto it = n.begin(); it != n.end(); ++it) {
-			arr.push_back(YamlNodeToToml(*it));
+			arr.push_back(YamlNodeToToml<TomlValue>(*it));
 		}
-		return toml::ordered_value(arr);
+		return TomlValue(std::move(arr));
 	}
 	else if (n.IsNull()) {
-		return toml::ordered_value("");
+		return TomlValue("");
 	}
 	else if (n.IsScalar()) {
-		if (tag_is(n, "!!str")) {
-			return toml::ordered_value(scalar_of(n));
+		const auto r = resolveYamlScalar(n);
+		switch (r.kind) {
+			case YamlScalar::Kind::Null:  return TomlValue("");  // null
+			case YamlScalar::Kind::Bool:  return TomlValue(r.b);
+			case YamlScalar::Kind::Int:   return TomlValue(r.i);
+			case YamlScalar::Kind::Uint:  return TomlValue((double)r.u); // beyond TOML's int64
+			case YamlScalar::Kind::Float: return TomlValue(r.f);
+			default:                      return TomlValue(n.Scalar());
 		}
-
-		try { return toml::ordered_value(n.as<bool>()); } catch (...) {}
-		try { return toml::ordered_value((std::int64_t)n.as<long long>()); } catch (...) {}
-		try { return toml::ordered_value(n.as<double>()); } catch (...) {}
-
-		const auto s = scalar_of(n);
-		if (is_null_token(s)) {
-			return toml::ordered_value("");  // null
-		}
-		return toml::ordered_value(s);
 	}
 	
-	return toml::ordered_value("");
+	return TomlValue("");
+}
+// Calls f with whichever JSON/TOML ordering the document holds.
+template<class F>
+static Result WithJson(const Document& in, F&& f){
+	if (auto* j = in.get_if<Document::UJsonDom>()) return f(*j);
+	return f(in.ojson());
+}
+template<class F>
+static Result WithToml(const Document& in, F&& f){
+	if (auto* v = in.get_if<Document::UTomlDom>()) return f(*v);
+	return f(in.toml());
 }
-static struct _RegisterDirect {
-	_RegisterDirect(){
-		// OrderedJSON ⇔ YAML
-		Converter::instance().registerNativeBridge(Format::Json, Format::Yaml,
-			  [](const Document& in, Document& out, const Options& opt)->Result{
-			if (in.type != Document::Type::Json) return {false,"in is not ojson"};
-			const auto& j = std::get<nlohmann::ordered_json>(in.dom);
-			YAML::Node y; JsonToYAMLNode(y, j, opt);
-			out.type = Document::Type::Yaml; out.dom = std::move(y); return {};
-		});
-		
-		Converter::instance().registerNativeBridge(Format::Yaml, Format::Json,
-			  [](const Document& in, Document& out, const Options& opt)->Result{
-			if (in.type != Document::Type::Yaml) return {false,"in is not yaml"};
-			const auto& y = std::get<Document::YamlDom>(in.dom);
-			nlohmann::ordered_json j = YAMLNodeToOJson(y, opt);
-			out.type = Document::Type::Json; out.dom = std::move(j); return {};
-		});
 
-		// OrderedJSON ⇔ TOML
-		Converter::instance().registerNativeBridge(Format::Json, Format::Toml,
-			  [](const Document& in, Document& out, const Options& opt)->Result{
-			if (in.type != Document::Type::Json) return {false,"in is not ojson"};
-			const auto& j = std::get<nlohmann::ordered_json>(in.dom);
-			toml::ordered_table t; JsonToTomlTable(t, j, opt);
-			out.type = Document::Type::Toml; out.dom = std::move(t); return {};
+template<class BasicJson>
+static NativeBridge YamlToJsonBridge(){
+	return [](const Document& in, Document& out, const Options& opt)->Result{
+		if (in.type != Document::Type::Yaml) return {false,"in is not yaml"};
+		const auto& y = in.yaml();
+		BasicJson j = YAMLNodeToJson<BasicJson>(y, opt);
+		out.type = Document::Type::Json; out.dom = std::move(j); return {};
+	};
+}
+template<class TomlValue>
+static NativeBridge JsonToTomlBridge(){
+	return [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+		if (in.type != Document::Type::Json) return {false,"in is not json"};
+		return WithJson(in, [&](const auto& j)->Result{
+			if (!j.is_object()) return {false, "json root is not object"};
+			out.type = Document::Type::Toml; out.dom = JsonToTomlValue<TomlValue>(j); return {};
 		});
-		
-		Converter::instance().registerNativeBridge(Format::Toml, Format::Json,
-			  [](const Document& in, Document& out, const Options& opt)->Result{
-			if (in.type != Document::Type::Toml) return {false,"in is not toml"};
-			const auto& v = std::get<Document::TomlDom>(in.dom);
+	};
+}
+template<class BasicJson>
+static NativeBridge TomlToJsonBridge(){
+	return [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+		if (in.type != Document::Type::Toml) return {false,"in is not toml"};
+		return WithToml(in, [&](const auto& v)->Result{
 			if (!v.is_table()) return {false, "toml root is not table"};
-			auto j = TomlValueToJson<nlohmann::ordered_json>(v);
+			auto j = TomlValueToJson<BasicJson>(v);
 			out.type = Document::Type::Json; out.dom = std::move(j); return {};
 		});
+	};
+}
+template<class TomlValue>
+static NativeBridge YamlToTomlBridge(){
+	return [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+		if (in.type != Document::Type::Yaml) return {false,"in is not yaml"};
+		const auto& y = in.yaml();
+		if (!y.IsMap()) return {false, "yaml root is not map"};
+		TomlValue v = YamlNodeToToml<TomlValue>(y);
+		if (!v.is_table()) return {false, "converted toml is not table"};
+		out.type = Document::Type::Toml; out.dom = std::move(v); return {};
+	};
+}
+// Switches between the ordered and unordered DOM of the same format.
+template<class BasicJson>
+static NativeBridge JsonToJsonBridge(){
+	return [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+		if (in.type != Document::Type::Json) return {false,"in is not json"};
+		return WithJson(in, [&](const auto& j)->Result{
+			out.type = Document::Type::Json; out.dom = BasicJson(j); return {};
+		});
+	};
+}
+template<class TomlValue>
+static NativeBridge TomlToTomlBridge(){
+	return [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+		if (in.type != Document::Type::Toml) return {false,"in is not toml"};
+		return WithToml(in, [&](const auto& v)->Result{
+			out.type = Document::Type::Toml; out.dom = TomlValue(v); return {};
+		});
+	};
+}
+
+static struct _RegisterDirect {
+	_RegisterDirect(){
+		auto& c = Converter::instance();
+
+		// JSON ⇔ YAML
+		c.registerNativeBridge(Format::Json, Format::Yaml,
+			  [](const Document& in, Document& out, const Options& /*opt*/)->Result{
+			if (in.type != Document::Type::Json) return {false,"in is not json"};
+			return WithJson(in, [&](const auto& j)->Result{
+				YAML::NodeFactory f;
+				YAML::Node y = JsonToYAMLNode(f, j);
+				out.type = Document::Type::Yaml; out.dom = std::move(y); return {};
+			});
+		});
+		c.registerNativeBridge(Format::Yaml, Format::OrderedJson, YamlToJsonBridge<nlohmann::ordered_json>());
+		c.registerNativeBridge(Format::Yaml, Format::Json,        YamlToJsonBridge<nlohmann::json>());
+
+		// JSON ⇔ TOML
+		c.registerNativeBridge(Format::Json, Format::Toml,        JsonToTomlBridge<toml::ordered_value>());
+		c.registerNativeBridge(Format::Json, Format::OrderedToml, JsonToTomlBridge<toml::value>());
+		c.registerNativeBridge(Format::Toml, Format::OrderedJson, TomlToJsonBridge<nlohmann::ordered_json>());
+		c.registerNativeBridge(Format::Toml, Format::Json,        TomlToJsonBridge<nlohmann::json>());
 
 		// TOML -> YAML
-		Converter::instance().registerNativeBridge(Format::Toml, Format::Yaml,
+		c.registerNativeBridge(Format::Toml, Format::Yaml,
 							   [](const Document& in, Document& out, const Options& /*opt*/)->Result{
 			if (in.type != Document::Type::Toml) return {false,"in is not toml"};
-			const auto& v = std::get<Document::TomlDom>(in.dom);
-			if (!v.is_table()) return {false, "toml root is not table"};
-			YAML::Node y = TomlValueToYaml(v);
-			out.type = Document::Type::Yaml; out.dom = std::move(y); return {};
+			return WithToml(in, [&](const auto& v)->Result{
+				if (!v.is_table()) return {false, "toml root is not table"};
+				YAML::NodeFactory f;
+				YAML::Node y = TomlValueToYaml(f, v);
+				out.type = Document::Type::Yaml; out.dom = std::move(y); return {};
+			});
 		});
 
 		// YAML -> TOML
-		Converter::instance().registerNativeBridge(Format::Yaml, Format::Toml,
-							   [](const Document& in, Document& out, const Options& /*opt*/)->Result{
-			if (in.type != Document::Type::Yaml) return {false,"in is not yaml"};
-			const auto& y = std::get<Document::YamlDom>(in.dom);
-			if (!y.IsMap()) return {false, "yaml root is not map"};
-			toml::ordered_value v = YamlNodeToToml(y);
-			if (!v.is_table()) return {false, "converted toml is not table"};
-			out.type = Document::Type::Toml; out.dom = std::move(v); return {};
-		});
+		c.registerNativeBridge(Format::Yaml, Format::Toml,        YamlToTomlBridge<toml::ordered_value>());
+		c.registerNativeBridge(Format::Yaml, Format::OrderedToml, YamlToTomlBridge<toml::value>());
+
+		// ordered ⇔ unordered
+		c.registerNativeBridge(Format::Json, Format::OrderedJson, JsonToJsonBridge<nlohmann::ordered_json>());
+		c.registerNativeBridge(Format::Json, Format::Json,        JsonToJsonBridge<nlohmann::json>());
+		c.registerNativeBridge(Format::Toml, Format::Toml,        TomlToTomlBridge<toml::ordered_value>());
+		c.registerNativeBridge(Format::Toml, Format::OrderedToml, TomlToTomlBridge<toml::value>());
 	}
 } _direct;
 
@@ -1,5 +1,6 @@
 #pragma once
 #include <variant>
+#include <utility>
 #include <nlohmann/json.hpp>
 #include "yaml.h"
 #include "toml.hpp"
@@ -12,24 +13,70 @@ struct Document {
     using JsonDom = nlohmann::ordered_json;
     using YamlDom = YAML::Node;
     using TomlDom = toml::ordered_value;
+    using UJsonDom = nlohmann::json;
+    using UTomlDom = toml::value;
 
-    using Storage = std::variant<std::monostate, JsonDom, YamlDom, TomlDom>;
+    // Owned DOMs, followed by borrowed (non-owning) views of caller-held DOMs.
+    // A borrowed Document is only valid while the referenced DOM is alive.
+    using Storage = std::variant<std::monostate, JsonDom, YamlDom, TomlDom, UJsonDom, UTomlDom,
+                                 const JsonDom*, const YamlDom*, const TomlDom*,
+                                 const UJsonDom*, const UTomlDom*>;
 
     Type    type = Type::None;
     Storage dom;
 
+    Document() = default;
+
+    static Document borrow(const JsonDom& v){ return Document(Type::Json, &v); }
+    static Document borrow(const YamlDom& v){ return Document(Type::Yaml, &v); }
+    static Document borrow(const TomlDom& v){ return Document(Type::Toml, &v); }
+    static Document borrow(const UJsonDom& v){ return Document(Type::Json, &v); }
+    static Document borrow(const UTomlDom& v){ return Document(Type::Toml, &v); }
+
     bool empty() const { return type == Type::None; }
+    bool borrowed() const {
+        return std::holds_alternative<const JsonDom*>(dom)  || std::holds_alternative<const YamlDom*>(dom)
+            || std::holds_alternative<const TomlDom*>(dom)  || std::holds_alternative<const UJsonDom*>(dom)
+            || std::holds_alternative<const UTomlDom*>(dom);
+    }
+
+    // True if the DOM of type T is held, either owned or borrowed.
+    template<typename T> bool holds() const {
+        return std::holds_alternative<T>(dom) || std::holds_alternative<const T*>(dom);
+    }
+    template<typename T> const T* get_if() const {
+        if (auto p = std::get_if<const T*>(&dom)) return *p;
+        return std::get_if<T>(&dom);
+    }
 
+    // Mutable access requires an owned DOM.
     template<typename T>       T& as()       { return std::get<T>(dom); }
-    template<typename T> const T& as() const { return std::get<T>(dom); }
+    template<typename T> const T& as() const {
+        if (auto p = std::get_if<const T*>(&dom)) return **p;
+        return std::get<T>(dom);
+    }
+
+    // Moves the DOM out when owned, copies it when borrowed.
+    template<typename T> T take() {
+        if (auto p = std::get_if<const T*>(&dom)) return **p;
+        return std::move(std::get<T>(dom));
+    }
 
     JsonDom& ojson(){ return as<JsonDom>(); }
     YamlDom& yaml()        { return as<YamlDom>(); }
     TomlDom& toml()        { return as<TomlDom>(); }
+    UJsonDom& ujson()      { return as<UJsonDom>(); }
+    UTomlDom& utoml()      { return as<UTomlDom>(); }
 
     const JsonDom& ojson() const{ return as<JsonDom>(); }
     const YamlDom& yaml() const        { return as<YamlDom>(); }
     const TomlDom& toml() const        { return as<TomlDom>(); }
+    const UJsonDom& ujson() const      { return as<UJsonDom>(); }
+    const UTomlDom& utoml() const      { return as<UTomlDom>(); }
+
+private:
+    template<typename T>
+    Document(Type t, const T* p) : type(t), dom(p) {}
 };
 
 }} // namespace ofx::configbridge
@@ -0,0 +1,175 @@
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#if !defined(__cpp_lib_to_chars)
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+namespace ofx { namespace configbridge {
+
+namespace {
+#if defined(__cpp_lib_to_chars)
+char* writeFloat(char* first, char* last, double value, int precision){
+	std::to_chars_result r;
+	if (precision < 0) {
+		r = std::to_chars(first, last, value);
+	} else {
+		r = std::to_chars(first, last, value, std::chars_format::fixed, std::min(precision, kMaxFloatPrecision));
+	}
+	return r.ec == std::errc() ? r.ptr : first;
+}
+#else
+// No floating-point to_chars (e.g. Apple's libc++ before macOS 13.3): the
+// same text from snprintf, with the locale's decimal point turned into '.'.
+char* printFloat(char* first, char* last, const char* format, int precision, double value){
+	const int n = std::snprintf(first, (std::size_t)(last - first), format, precision, value);
+	if (n < 0 || n >= last - first) return first;
+	char* end = first + n;
+	const char* point = std::localeconv()->decimal_point;
+	const std::size_t size = std::strlen(point);
+	if (size == 1 && *point == '.') return end;
+	char* at = std::search(first, end, point, point + size);
+	if (at == end) return end;
+	*at = '.';
+	return std::copy(at + size, end, at + 1);
+}
+
+// Whether "<sign><digits>e<exponent>" reads back as value. The text has no
+// decimal point, so strtod reads it the same in any locale.
+bool readsBack(bool negative, const char* digits, int count, int exponent, double value){
+	char text[48];
+	char* t = text;
+	if (negative) *t++ = '-';
+	t = std::copy(digits, digits + count, t);
+	std::snprintf(t, 16, "e%d", exponent);
+	return std::strtod(text, nullptr) == value;
+}
+
+// Rounds the `count` digits up by one in the last place; returns false when
+// that carries into a new leading digit.
+bool roundUp(char* digits, int count){
+	for (int i = count - 1; i >= 0; --i) {
+		if (digits[i] != '9') { ++digits[i]; return true; }
+		digits[i] = '0';
+	}
+	digits[0] = '1';
+	return false;
+}
+
+// Shortest round-trip text, choosing fixed or scientific notation as
+// to_chars does: whichever is shorter, fixed on a tie.
+char* writeShortest(char* first, char* last, double value){
+	// digits of value well past the 17 that always read back
+	char exact[64];
+	std::snprintf(exact, sizeof(exact), "%.40e", value);
+	const char* p = exact;
+	const bool negative = *p == '-';
+	if (negative) ++p;
+	char all[48];
+	int total = 0;
+	for (; *p && *p != 'e'; ++p) if (*p >= '0' && *p <= '9') all[total++] = *p;
+	const int exact_exponent = std::atoi(p + 1);
+
+	// the fewest significant digits that read back, trying the nearest
+	// rounding before the other one; for normal values 15 always suffice
+	// when the shortest form has 15 or fewer
+	char mantissa[20];
+	int count = std::fpclassify(value) == FP_SUBNORMAL ? 1 : 15;
+	int exponent = exact_exponent;
+	for (;; ++count) {
+		// an exact half rounds to even, as to_chars does
+		const bool half = all[count] == '5' && std::all_of(all + count + 1, all + total, [](char c){ return c == '0'; });
+		const bool nearest_up = half ? (all[count - 1] - '0') % 2 == 1 : all[count] >= '5';
+		bool found = false;
+		for (bool up : {nearest_up, !nearest_up}) {
+			std::copy(all, all + count, mantissa);
+			exponent = exact_exponent;
+			if (up && !roundUp(mantissa, count)) ++exponent;
+			if (count == 17 || readsBack(negative, mantissa, count, exponent - count + 1, value)) { found = true; break; }
+		}
+		if (found) break;
+	}
+	while (count > 1 && mantissa[count - 1] == '0') --count;
+
+	char fixed[400];
+	char* f = fixed;
+	if (negative) *f++ = '-';
+	if (exponent >= count - 1) {
+		// an integer, written with all its digits
+		f = printFloat(fixed, fixed + sizeof(fixed), "%.*f", 0, value);
+	} else if (exponent >= 0) {
+		f = std::copy(mantissa, mantissa + exponent + 1, f);
+		*f++ = '.';
+		f = std::copy(mantissa + exponent + 1, mantissa + count, f);
+	} else {
+		*f++ = '0';
+		*f++ = '.';
+		for (int i = 1; i < -exponent; ++i) *f++ = '0';
+		f = std::copy(mantissa, mantissa + count, f);
+	}
+
+	char scientific[32];
+	char* s = scientific;
+	if (negative) *s++ = '-';
+	*s++ = mantissa[0];
+	if (count > 1) { *s++ = '.'; s = std::copy(mantissa + 1, mantissa + count, s); }
+	s += std::snprintf(s, 8, "e%c%02d", exponent < 0 ? '-' : '+', std::abs(exponent));
+
+	const bool use_fixed = f - fixed <= s - scientific;
+	const char* from = use_fixed ? fixed : scientific;
+	const char* to   = use_fixed ? f : s;
+	if (to - from > last - first) return first;
+	return std::copy(from, to, first);
+}
+
+char* writeFloat(char* first, char* last, double value, int precision){
+	if (std::isnan(value)) {
+		const char* text = std::signbit(value) ? "-nan" : "nan";
+		return std::copy(text, text + std::strlen(text), first);
+	}
+	if (std::isinf(value)) {
+		const char* text = value < 0 ? "-inf" : "inf";
+		return std::copy(text, text + std::strlen(text), first);
+	}
+	if (precision < 0) return writeShortest(first, last, value);
+	return printFloat(first, last, "%.*f", std::min(precision, kMaxFloatPrecision), value);
+}
+#endif
+}
+
+char* formatFloat(char* first, char* last, double value, int precision){
+	// keep room for an appended ".0"
+	char* end = writeFloat(first, last - 2, value, precision);
+	if (end == first) return first;
+	if (!std::isfinite(value)) return end;
+
+	char* dot = std::find(first, end, '.');
+	if (dot == end) {
+		if (std::find(first, end, 'e') == end) { *end++ = '.'; *end++ = '0'; }
+		return end;
+	}
+	if (precision >= 0) {
+		// fixed notation: strip trailing zeros, keep at least one decimal digit
+		while (end - dot > 2 && end[-1] == '0') --end;
+	}
+	return end;
+}
+
+void appendFloat(std::string& out, double value, int precision){
+	char buf[kFloatBufferSize];
+	char* end = formatFloat(buf, buf + sizeof(buf), value, precision);
+	out.append(buf, end);
+}
+
+std::string formatFloat(double value, int precision){
+	std::string s;
+	appendFloat(s, value, precision);
+	return s;
+}
+
+}} // namespace ofx::configbridge
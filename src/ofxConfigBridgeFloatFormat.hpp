@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace ofx { namespace configbridge {
+
+// Locale-independent float formatting shared by all writers.
+//
+// precision >= 0: fixed notation with that many digits after the decimal point,
+//                 trailing zeros stripped (at least one decimal digit is kept).
+// precision <  0: shortest representation that round-trips to the same double.
+//
+// Finite results always read back as floats ("1" becomes "1.0").
+// Non-finite values are written as "inf", "-inf" or "nan".
+
+// Large enough for any double in fixed notation at the maximum precision.
+constexpr int         kMaxFloatPrecision = 64;
+constexpr std::size_t kFloatBufferSize   = 400;
+
+// Writes into [first, last) and returns the end of the written text.
+// The range must hold at least kFloatBufferSize chars.
+char* formatFloat(char* first, char* last, double value, int precision);
+
+void        appendFloat(std::string& out, double value, int precision);
+std::string formatFloat(double value, int precision);
+
+}} // namespace ofx::configbridge
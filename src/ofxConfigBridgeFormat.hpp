@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string_view>
 #include <string>
 #include <algorithm>
@@ -6,6 +7,8 @@
 namespace ofx { namespace configbridge {
 
 enum class Format { Auto, Json, OrderedJson, Yaml, Toml, OrderedToml, Ini, Xml };
+// Number of Format values, for tables indexed by format.
+constexpr std::size_t kFormatCount = static_cast<std::size_t>(Format::Xml) + 1;
 
 inline Format guess_format(std::string_view path){
     auto pos = path.rfind('.');
@@ -27,7 +30,12 @@ struct Result {
 };
 
 struct Options {
+    // Digits after the decimal point. Trailing zeros are dropped but one
+    // decimal is always kept, so floats read back as floats: 2.50 -> "2.5",
+    // and 3 -> "3.0" even at precision 0. Negative = shortest round-trip.
     int float_precision = 6;
+    bool compact = false;    // single-line output where the format allows it (JSON)
+    bool atomic_save = false; // saveFile also flushes the new file to disk before it replaces the target
 };
 
 }} // namespace ofx::configbridge
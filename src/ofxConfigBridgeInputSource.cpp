@@ -0,0 +1,96 @@
+#include "ofxConfigBridgeInputSource.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#define OFX_CONFIGBRIDGE_HAS_MMAP
+#endif
+
+namespace ofx { namespace configbridge {
+
+namespace {
+#if defined(_WIN32)
+int openForRead(const std::string& path){ return ::_open(path.c_str(), _O_RDONLY | _O_BINARY); }
+long readSome(int fd, char* data, std::size_t size){
+	return ::_read(fd, data, (unsigned)std::min<std::size_t>(size, 1u << 30));
+}
+int closeFile(int fd){ return ::_close(fd); }
+bool regularFileSize(int fd, std::size_t& size){
+	struct _stat64 st;
+	if (::_fstat64(fd, &st) != 0 || !(st.st_mode & _S_IFREG)) return false;
+	size = (std::size_t)st.st_size;
+	return true;
+}
+#else
+int openForRead(const std::string& path){ return ::open(path.c_str(), O_RDONLY | O_CLOEXEC); }
+long readSome(int fd, char* data, std::size_t size){ return (long)::read(fd, data, size); }
+int closeFile(int fd){ return ::close(fd); }
+bool regularFileSize(int fd, std::size_t& size){
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+	size = (std::size_t)st.st_size;
+	return true;
+}
+#endif
+
+// Reads to end of file into `buffer`, starting from `expected` bytes of room.
+bool readAll(int fd, std::vector<char>& buffer, std::size_t expected, std::size_t& size){
+	size = 0;
+	if (buffer.size() < expected + 1) buffer.resize(expected + 1); // +1 detects growth
+	for (;;) {
+		if (size == buffer.size()) buffer.resize(buffer.size() * 2 + 4096);
+		const long n = readSome(fd, buffer.data() + size, buffer.size() - size);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		if (n == 0) return true;
+		size += (std::size_t)n;
+	}
+}
+}
+
+void InputSource::close(){
+#if defined(OFX_CONFIGBRIDGE_HAS_MMAP)
+	if (mapping_) ::munmap(mapping_, size_);
+#endif
+	mapping_ = nullptr;
+	data_ = "";
+	size_ = 0;
+}
+
+Result InputSource::open(const std::string& path){
+	close();
+	const int fd = openForRead(path);
+	if (fd < 0) return Result{false, "open file for read failed"};
+
+	std::size_t size = 0;
+	const bool regular = regularFileSize(fd, size);
+#if defined(OFX_CONFIGBRIDGE_HAS_MMAP)
+	if (regular && size >= kMapThreshold) {
+		void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			::posix_madvise(p, size, POSIX_MADV_SEQUENTIAL);
+			closeFile(fd); // the mapping stays valid
+			mapping_ = p;
+			data_ = static_cast<const char*>(p);
+			size_ = size;
+			return {};
+		}
+	}
+#endif
+	const bool ok = readAll(fd, buffer_, regular ? size : 0, size);
+	closeFile(fd);
+	if (!ok) return Result{false, "read file failed"};
+	data_ = buffer_.data();
+	size_ = size;
+	return {};
+}
+
+}} // namespace ofx::configbridge
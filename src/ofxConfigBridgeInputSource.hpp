@@ -0,0 +1,39 @@
+#pragma once
+#include "ofxConfigBridgeFormat.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+// Read-only bytes of a file, handed to the parsers as a view.
+//
+// Regular files of at least kMapThreshold bytes are memory-mapped with a
+// sequential-access hint, so parsers read the page cache without a copy.
+// Smaller files, pipes and platforms without mmap are read into a buffer
+// owned by the source, which a reused InputSource keeps between files.
+// The view is valid until the next open() or close().
+class InputSource {
+public:
+    static constexpr std::size_t kMapThreshold = 64 * 1024;
+
+    InputSource() = default;
+    ~InputSource(){ close(); }
+    InputSource(const InputSource&) = delete;
+    InputSource& operator=(const InputSource&) = delete;
+
+    Result open(const std::string& path);
+    void close();
+
+    std::string_view text() const { return {data_, size_}; }
+    bool mapped() const { return mapping_ != nullptr; }
+
+private:
+    const char*       data_ = "";
+    std::size_t       size_ = 0;
+    void*             mapping_ = nullptr;
+    std::vector<char> buffer_;
+};
+
+}} // namespace ofx::configbridge
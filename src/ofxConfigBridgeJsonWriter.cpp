@@ -0,0 +1,212 @@
+#include "ofxConfigBridgeJsonWriter.hpp"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
+#include "ofxConfigBridgeStringEscape.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+namespace {
+constexpr int kIndentWidth = 2;
+
+constexpr std::size_t kIndentChunk = 128;
+const char* indentSpaces(){
+	static const std::string spaces(kIndentChunk, ' ');
+	return spaces.data();
+}
+
+void appendNewline(std::string& out, int depth){
+	out += '\n';
+	for (std::size_t n = (std::size_t)depth * kIndentWidth; n > 0; ) {
+		std::size_t chunk = std::min(n, kIndentChunk);
+		out.append(indentSpaces(), chunk);
+		n -= chunk;
+	}
+}
+
+template<class Int>
+void appendInt(std::string& out, Int v){
+	char buf[24];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v);
+	out.append(buf, r.ptr);
+}
+}
+
+void JsonWriter::newline(int depth){
+	if (compact_) return;
+	appendNewline(out_, depth);
+}
+
+void JsonWriter::flushToSink(){
+	sink_->write(out_);
+	out_.clear();
+}
+
+void JsonWriter::writeString(std::string_view s){
+	appendQuoted(out_, s, StringStyle::Json);
+}
+
+template<class BasicJson>
+void JsonWriter::write(const BasicJson& j){
+	if (out_.capacity() - out_.size() < 4096) out_.reserve(out_.size() + 4096);
+	writeValue(j, 0);
+	if (sink_) flushToSink();
+}
+
+template<class BasicJson>
+void JsonWriter::writeObject(const BasicJson& j, int depth){
+	if (j.empty()) { out_ += "{}"; return; }
+	out_ += '{';
+	bool first = true;
+	auto member = [&](const std::string& key, const BasicJson& value){
+		if (!first) out_ += ',';
+		first = false;
+		newline(depth + 1);
+		writeString(key);
+		out_ += compact_ ? ":" : ": ";
+		writeValue(value, depth + 1);
+		spill();
+	};
+	constexpr bool already_sorted = std::is_same_v<BasicJson, nlohmann::json>;
+	if (sort_keys_ && !already_sorted) {
+		// sort views of the members instead of re-encoding into nlohmann::json
+		std::vector<typename BasicJson::const_iterator> items;
+		items.reserve(j.size());
+		for (auto it = j.begin(); it != j.end(); ++it) items.push_back(it);
+		std::sort(items.begin(), items.end(), [](const auto& a, const auto& b){ return a.key() < b.key(); });
+		for (const auto& it : items) member(it.key(), it.value());
+	} else {
+		for (auto it = j.begin(); it != j.end(); ++it) member(it.key(), it.value());
+	}
+	newline(depth);
+	out_ += '}';
+}
+
+template<class BasicJson>
+void JsonWriter::writeArray(const BasicJson& j, int depth){
+	if (j.empty()) { out_ += "[]"; return; }
+	out_ += '[';
+	bool first = true;
+	for (const auto& elem : j) {
+		if (!first) out_ += ',';
+		first = false;
+		newline(depth + 1);
+		writeValue(elem, depth + 1);
+		spill();
+	}
+	newline(depth);
+	out_ += ']';
+}
+
+template<class BasicJson>
+void JsonWriter::writeValue(const BasicJson& j, int depth){
+	using value_t = nlohmann::detail::value_t;
+	switch (j.type()) {
+		case value_t::object:          writeObject(j, depth); break;
+		case value_t::array:           writeArray(j, depth); break;
+		case value_t::string:          writeString(j.template get_ref<const std::string&>()); break;
+		case value_t::boolean:         out_ += j.template get<bool>() ? "true" : "false"; break;
+		case value_t::number_integer:  appendInt(out_, j.template get<std::int64_t>()); break;
+		case value_t::number_unsigned: appendInt(out_, j.template get<std::uint64_t>()); break;
+		case value_t::number_float: {
+			const double v = j.template get<double>();
+			if (std::isfinite(v)) appendFloat(out_, v, precision_);
+			else                  out_ += "null"; // not representable in JSON
+			break;
+		}
+		default:                       out_ += "null"; break;
+	}
+}
+
+template void JsonWriter::write(const nlohmann::json&);
+template void JsonWriter::write(const nlohmann::ordered_json&);
+
+void JsonEventWriter::beginValue(){
+	if (after_key_) { after_key_ = false; return; }
+	if (has_members_.empty()) return;
+	if (has_members_.back()) out_ += ',';
+	has_members_.back() = true;
+	if (!compact_) appendNewline(out_, (int)has_members_.size());
+}
+
+void JsonEventWriter::key(std::string_view k){
+	if (has_members_.back()) out_ += ',';
+	has_members_.back() = true;
+	if (!compact_) appendNewline(out_, (int)has_members_.size());
+	appendQuoted(out_, k, StringStyle::Json);
+	out_ += compact_ ? ":" : ": ";
+	after_key_ = true;
+}
+
+void JsonEventWriter::beginObject(){
+	beginValue();
+	out_ += '{';
+	has_members_.push_back(false);
+}
+
+void JsonEventWriter::beginArray(){
+	beginValue();
+	out_ += '[';
+	has_members_.push_back(false);
+}
+
+void JsonEventWriter::endContainer(char close){
+	const bool members = has_members_.back();
+	has_members_.pop_back();
+	if (members && !compact_) appendNewline(out_, (int)has_members_.size());
+	out_ += close;
+	spill();
+}
+
+void JsonEventWriter::endObject(){ endContainer('}'); }
+void JsonEventWriter::endArray(){ endContainer(']'); }
+
+void JsonEventWriter::null(){
+	beginValue();
+	out_ += "null";
+	spill();
+}
+
+void JsonEventWriter::boolean(bool v){
+	beginValue();
+	out_ += v ? "true" : "false";
+	spill();
+}
+
+void JsonEventWriter::integer(std::int64_t v){
+	beginValue();
+	appendInt(out_, v);
+	spill();
+}
+
+void JsonEventWriter::uinteger(std::uint64_t v){
+	beginValue();
+	appendInt(out_, v);
+	spill();
+}
+
+void JsonEventWriter::floating(double v){
+	beginValue();
+	if (std::isfinite(v)) appendFloat(out_, v, precision_);
+	else                  out_ += "null"; // not representable in JSON
+	spill();
+}
+
+void JsonEventWriter::string(std::string_view s){
+	beginValue();
+	appendQuoted(out_, s, StringStyle::Json);
+	spill();
+}
+
+void JsonEventWriter::flush(){
+	sink_.write(out_);
+	out_.clear();
+}
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,83 @@
+#pragma once
+#include "ofxConfigBridgeFormat.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+class IOutputSink;
+
+// Serialises nlohmann DOMs by appending to a caller-owned string, so repeated
+// dumps into the same string reuse its capacity.
+// Pretty output indents by two spaces; Options::compact writes a single line.
+// Floats follow Options::float_precision (see ofxConfigBridgeFloatFormat.hpp).
+// Given a sink, `out` is only a staging buffer: the text is handed to the sink
+// in chunks of about kSpillSize as it is written, and `out` is left empty.
+class JsonWriter {
+public:
+    static constexpr std::size_t kSpillSize = 64 * 1024;
+
+    JsonWriter(std::string& out, const Options& opt, bool sort_keys = false, IOutputSink* sink = nullptr)
+    : out_(out), sink_(sink), precision_(opt.float_precision), compact_(opt.compact), sort_keys_(sort_keys) {}
+
+    // Supported for nlohmann::json and nlohmann::ordered_json.
+    template<class BasicJson> void write(const BasicJson& j);
+
+    void writeString(std::string_view s);
+
+private:
+    template<class BasicJson> void writeValue(const BasicJson& j, int depth);
+    template<class BasicJson> void writeObject(const BasicJson& j, int depth);
+    template<class BasicJson> void writeArray(const BasicJson& j, int depth);
+    void newline(int depth);
+    void spill(){ if (sink_ && out_.size() >= kSpillSize) flushToSink(); }
+    void flushToSink();
+
+    std::string& out_;
+    IOutputSink* sink_;
+    int  precision_;
+    bool compact_;
+    bool sort_keys_;
+};
+
+// Writes JSON from a sequence of events with JsonWriter's layout, for bridges
+// that convert without building a DOM. Inside an object each value follows
+// key(). Text goes to the sink in chunks of about JsonWriter::kSpillSize;
+// flush() hands over the rest once the document is complete.
+class JsonEventWriter {
+public:
+    JsonEventWriter(IOutputSink& sink, const Options& opt)
+    : sink_(sink), precision_(opt.float_precision), compact_(opt.compact) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view k);
+
+    void null();
+    void boolean(bool v);
+    void integer(std::int64_t v);
+    void uinteger(std::uint64_t v);
+    void floating(double v);
+    void string(std::string_view s);
+
+    void flush();
+
+private:
+    void beginValue();
+    void endContainer(char close);
+    void spill(){ if (out_.size() >= JsonWriter::kSpillSize) flush(); }
+
+    IOutputSink&      sink_;
+    std::string       out_;
+    std::vector<bool> has_members_; // one entry per open container
+    bool              after_key_ = false;
+    int               precision_;
+    bool              compact_;
+};
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+// Append-only construction of JSON objects and TOML tables.
+//
+// ordered_json and toml::ordered_table are vector-backed and scan linearly on
+// every operator[], so filling them key by key is O(n^2). The builders append
+// instead. Sources that already guarantee unique keys (JSON, TOML) skip all
+// lookups; sources that may repeat a key (YAML maps) pass check_duplicates,
+// which keeps a hashed index of the keys seen so far. A repeated key keeps its
+// first position and takes the last value, as operator[] assignment would.
+
+namespace detail {
+
+template<class C, class = void>
+struct is_vector_backed : std::false_type {};
+template<class C>
+struct is_vector_backed<C, std::void_t<decltype(std::declval<C&>().reserve(std::size_t{}))>>
+    : std::true_type {};
+
+// Maps keys to positions in a vector of pairs. The views point into the
+// vector, so the index is rebuilt whenever the vector reallocates.
+class KeyIndex {
+public:
+    const std::size_t* find(std::string_view key) const {
+        auto it = index_.find(key);
+        return it == index_.end() ? nullptr : &it->second;
+    }
+    template<class Pairs>
+    void added(const Pairs& pairs, const void* old_data) {
+        if (static_cast<const void*>(pairs.data()) != old_data) {
+            index_.clear();
+            index_.reserve(pairs.capacity());
+            for (std::size_t i = 0; i < pairs.size(); ++i)
+                index_.emplace(std::string_view((pairs.begin() + i)->first), i);
+        } else {
+            index_.emplace(std::string_view(pairs.back().first), pairs.size() - 1);
+        }
+    }
+
+private:
+    std::unordered_map<std::string_view, std::size_t> index_;
+};
+
+} // namespace detail
+
+template<class BasicJson>
+class JsonObjectBuilder {
+    using Map = typename BasicJson::object_t;
+
+public:
+    explicit JsonObjectBuilder(std::size_t reserve, bool check_duplicates = false)
+        : obj_(BasicJson::object()), check_(check_duplicates) {
+        if constexpr (detail::is_vector_backed<Map>::value)
+            // The pairs hold const keys and cannot be moved: growing would
+            // deep-copy every value, so reserve the final size up front.
+            map().reserve(reserve);
+    }
+
+    void add(std::string key, BasicJson value) {
+        auto& m = map();
+        if constexpr (detail::is_vector_backed<Map>::value) {
+            if (check_) {
+                if (auto i = index_.find(key)) { (m.begin() + *i)->second = std::move(value); return; }
+                const void* old_data = m.data();
+                m.emplace_back(std::move(key), std::move(value));
+                index_.added(m, old_data);
+                return;
+            }
+            m.emplace_back(std::move(key), std::move(value));
+        } else {
+            m.insert_or_assign(std::move(key), std::move(value));
+        }
+    }
+
+    BasicJson finish() { return std::move(obj_); }
+
+private:
+    Map& map() { return obj_.template get_ref<Map&>(); }
+
+    BasicJson         obj_;
+    bool              check_;
+    detail::KeyIndex  index_;
+};
+
+template<class TomlValue>
+class TomlTableBuilder {
+    using Table = typename TomlValue::table_type;
+
+public:
+    explicit TomlTableBuilder(std::size_t reserve, bool check_duplicates = false)
+        : check_(check_duplicates) {
+        items_.reserve(reserve);
+    }
+
+    void add(std::string key, TomlValue value) {
+        if (check_) {
+            if (auto i = index_.find(key)) { items_[*i].second = std::move(value); return; }
+            const void* old_data = items_.data();
+            items_.emplace_back(std::move(key), std::move(value));
+            index_.added(items_, old_data);
+            return;
+        }
+        items_.emplace_back(std::move(key), std::move(value));
+    }
+
+    // The range constructor of toml tables does not check for duplicates,
+    // which add() has already taken care of.
+    TomlValue finish() {
+        Table t(std::make_move_iterator(items_.begin()), std::make_move_iterator(items_.end()));
+        items_.clear();
+        return TomlValue(std::move(t));
+    }
+
+private:
+    std::vector<std::pair<std::string, TomlValue>> items_;
+    bool              check_;
+    detail::KeyIndex  index_;
+};
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,192 @@
+#include "ofxConfigBridgeOutputSink.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ofx { namespace configbridge {
+
+namespace {
+#if defined(_WIN32)
+int openForWrite(const std::string& path){
+	return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+int createNew(const std::string& path){
+	return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+void copyMode(const std::string&, int){}
+// _write takes an unsigned int count
+long writeSome(int fd, const char* data, std::size_t size){
+	return ::_write(fd, data, (unsigned)std::min<std::size_t>(size, 1u << 30));
+}
+bool syncFile(int fd){ return ::_commit(fd) == 0; }
+bool truncateFile(int fd){ return ::_lseek(fd, 0, SEEK_SET) == 0 && ::_chsize_s(fd, 0) == 0; }
+int closeFile(int fd){ return ::_close(fd); }
+#else
+int openForWrite(const std::string& path){
+	return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+}
+int createNew(const std::string& path){
+	return ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+}
+// the new file replaces `path`, so it keeps its permissions
+void copyMode(const std::string& path, int fd){
+	struct stat st;
+	if (::stat(path.c_str(), &st) == 0) ::fchmod(fd, st.st_mode & 07777);
+}
+long writeSome(int fd, const char* data, std::size_t size){
+	return (long)::write(fd, data, size);
+}
+bool syncFile(int fd){ return ::fsync(fd) == 0; }
+bool truncateFile(int fd){ return ::lseek(fd, 0, SEEK_SET) == 0 && ::ftruncate(fd, 0) == 0; }
+int closeFile(int fd){ return ::close(fd); }
+#endif
+
+// Creates "<path>.XXXXXX" with a suffix no file has yet, as mkstemp does.
+int createTemp(const std::string& path, std::string& temp){
+	static constexpr char kChars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+	std::random_device seed;
+	std::mt19937 gen(seed());
+	std::uniform_int_distribution<int> pick(0, sizeof(kChars) - 2);
+	for (int attempt = 0; attempt < 100; ++attempt) {
+		temp = path + ".XXXXXX";
+		for (auto i = temp.size() - 6; i < temp.size(); ++i) temp[i] = kChars[pick(gen)];
+		const int fd = createNew(temp);
+		if (fd >= 0 || errno != EEXIST) return fd;
+	}
+	return -1;
+}
+
+bool writeAll(int fd, const char* data, std::size_t size){
+	while (size > 0) {
+		const long n = writeSome(fd, data, size);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		data += n;
+		size -= (std::size_t)n;
+	}
+	return true;
+}
+}
+
+FileSink::~FileSink(){
+	close();
+	removeTemp();
+}
+
+Result FileSink::open(const std::string& path, const Options& opt){
+	close();
+	removeTemp();
+	// a symlink stays in place; the file it points to is replaced
+	std::error_code ec;
+	path_ = path;
+	if (std::filesystem::is_symlink(path, ec)) {
+		path_ = std::filesystem::weakly_canonical(path, ec).string();
+		if (ec) return Result{false, "open file for write failed"};
+	}
+	durable_ = opt.atomic_save;
+	failed_ = false;
+	used_ = 0;
+	const auto type = std::filesystem::status(path_, ec).type();
+	if (type == std::filesystem::file_type::not_found || type == std::filesystem::file_type::regular) {
+		fd_ = createTemp(path_, temp_path_);
+		if (fd_ < 0) temp_path_.clear();
+		else         copyMode(path_, fd_);
+	} else {
+		// devices and pipes are written in place
+		fd_ = openForWrite(path_);
+	}
+	if (fd_ < 0) return Result{false, "open file for write failed"};
+	if (!buffer_) buffer_.reset(new char[kBufferSize]);
+	return {};
+}
+
+void FileSink::write(const char* data, std::size_t size){
+	if (!good()) return;
+	if (used_ + size <= kBufferSize) {
+		std::memcpy(buffer_.get() + used_, data, size);
+		used_ += size;
+		return;
+	}
+	if (!flush()) return;
+	if (size >= kBufferSize) {
+		// large pieces go straight to the file
+		if (!writeAll(fd_, data, size)) failed_ = true;
+		return;
+	}
+	std::memcpy(buffer_.get(), data, size);
+	used_ = size;
+}
+
+bool FileSink::flush(){
+	if (used_ > 0 && !writeAll(fd_, buffer_.get(), used_)) failed_ = true;
+	used_ = 0;
+	return !failed_;
+}
+
+void FileSink::close(){
+	if (fd_ < 0) return;
+	if (closeFile(fd_) != 0) failed_ = true;
+	fd_ = -1;
+}
+
+bool FileSink::restart(){
+	if (fd_ < 0 || temp_path_.empty()) return false;
+	used_ = 0;
+	failed_ = !truncateFile(fd_);
+	return !failed_;
+}
+
+void FileSink::removeTemp(){
+	if (temp_path_.empty()) return;
+	std::remove(temp_path_.c_str());
+	temp_path_.clear();
+}
+
+Result FileSink::commit(){
+	if (fd_ < 0) return Result{false, "file is not open"};
+	flush();
+	if (durable_ && !failed_ && !syncFile(fd_)) failed_ = true;
+	close();
+	if (failed_) return Result{false, "write file failed"};
+	if (temp_path_.empty()) return {};
+	std::error_code ec;
+	std::filesystem::rename(temp_path_, path_, ec);
+	if (ec) return Result{false, "replace file failed"};
+	temp_path_.clear();
+	return {};
+}
+
+SinkStreamBuf::SinkStreamBuf(IOutputSink& sink) : sink_(sink), buffer_(new char[kBufferSize]) {
+	setp(buffer_.get(), buffer_.get() + kBufferSize);
+}
+
+SinkStreamBuf::int_type SinkStreamBuf::overflow(int_type ch){
+	if (sync() != 0) return traits_type::eof();
+	if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+int SinkStreamBuf::sync(){
+	sink_.write(pbase(), (std::size_t)(pptr() - pbase()));
+	setp(buffer_.get(), buffer_.get() + kBufferSize);
+	return sink_.good() ? 0 : -1;
+}
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,99 @@
+#pragma once
+#include "ofxConfigBridgeFormat.hpp"
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace ofx { namespace configbridge {
+
+// Destination for IAdapter::dump. Writers hand over text in chunks as they
+// produce it, so a dump never needs the whole document in memory.
+// Errors are sticky: after a failed write, good() stays false and later
+// writes are ignored.
+class IOutputSink {
+public:
+    virtual ~IOutputSink() = default;
+    virtual void write(const char* data, std::size_t size) = 0;
+    virtual bool good() const { return true; }
+    // Drops everything written so far so that a conversion can start over;
+    // returns false if the sink cannot.
+    virtual bool restart() { return false; }
+
+    void write(std::string_view s){ write(s.data(), s.size()); }
+};
+
+// Appends to a caller-owned string.
+class StringSink final : public IOutputSink {
+public:
+    explicit StringSink(std::string& out) : out_(out), start_(out.size()) {}
+    using IOutputSink::write;
+    void write(const char* data, std::size_t size) override { out_.append(data, size); }
+    bool restart() override { out_.resize(start_); return true; }
+
+private:
+    std::string& out_;
+    std::size_t  start_;
+};
+
+// Writes a file through a large buffer straight to its file descriptor.
+//
+// The text goes to a new "<path>.XXXXXX" next to the target, created with the
+// target's permissions, and commit() renames it over `path`. A failed or
+// abandoned save therefore leaves the old file as it was, and readers see
+// either the old file or the complete new one. A sink destroyed without
+// commit() removes the temporary file. With Options::atomic_save, commit()
+// also flushes the new file to disk before the rename. Devices and pipes are
+// written in place.
+class FileSink final : public IOutputSink {
+public:
+    static constexpr std::size_t kBufferSize = 1 << 20;
+
+    FileSink() = default;
+    ~FileSink() override;
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    Result open(const std::string& path, const Options& opt);
+    using IOutputSink::write;
+    void write(const char* data, std::size_t size) override;
+    bool good() const override { return fd_ >= 0 && !failed_; }
+    // Empties the temporary file; devices and pipes cannot start over.
+    bool restart() override;
+    // Flushes and closes the file, then renames it into place.
+    Result commit();
+
+private:
+    bool flush();
+    void close();
+    void removeTemp();
+
+    int                     fd_ = -1;
+    bool                    failed_ = false;
+    bool                    durable_ = false;
+    std::string             path_;
+    std::string             temp_path_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t             used_ = 0;
+};
+
+// Lets writers that need a std::ostream, such as YAML::Emitter, write to an
+// IOutputSink: each full buffer is handed to the sink, and pubsync() hands
+// over the rest.
+class SinkStreamBuf final : public std::streambuf {
+public:
+    static constexpr std::size_t kBufferSize = 64 * 1024;
+
+    explicit SinkStreamBuf(IOutputSink& sink);
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+private:
+    IOutputSink&            sink_;
+    std::unique_ptr<char[]> buffer_;
+};
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,143 @@
+#include "ofxConfigBridgeConverter.hpp"
+#include "ofxConfigBridgeObjectBuilder.hpp"
+#include "ofxConfigBridgeYamlEvents.hpp"
+#include <nlohmann/json.hpp>
+#include "toml.hpp"
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Parse bridges that build the target DOM straight from parser events, so
+// the source DOM never exists.
+
+namespace ofx { namespace configbridge {
+
+namespace {
+template<class Value>
+constexpr bool is_toml_v = std::is_same_v<Value, toml::value> || std::is_same_v<Value, toml::ordered_value>;
+
+// Builds a JSON or TOML value from YamlEvents with the results of
+// YAMLNodeToJson and YamlNodeToToml. Open containers stage their children
+// and build the value once they close, so vector-backed objects are filled
+// in one pass. The stages are deques: toml11 values have no noexcept move,
+// so a growing vector would deep-copy them. YAML maps may repeat a key; the
+// last value wins at the first position.
+template<class Value>
+class DomBuilder {
+public:
+	void beginObject(){ frames_.emplace_back(true); }
+	void beginArray(){ frames_.emplace_back(false); }
+	void key(const std::string& k){ frames_.back().key = k; }
+
+	void endObject(){
+		Frame f = pop();
+		if constexpr (is_toml_v<Value>) {
+			// the members are already unique
+			typename Value::table_type t(std::make_move_iterator(f.members.begin()), std::make_move_iterator(f.members.end()));
+			add(Value(std::move(t)));
+		} else {
+			JsonObjectBuilder<Value> obj(f.members.size());
+			for (auto& m : f.members) obj.add(std::move(m.first), std::move(m.second));
+			add(obj.finish());
+		}
+	}
+	void endArray(){
+		Frame f = pop();
+		std::vector<Value> items;
+		items.reserve(f.items.size());
+		items.insert(items.end(), std::make_move_iterator(f.items.begin()), std::make_move_iterator(f.items.end()));
+		if constexpr (is_toml_v<Value>) {
+			add(Value(std::move(items)));
+		} else {
+			Value a = Value::array();
+			a.template get_ref<typename Value::array_t&>() = std::move(items);
+			add(std::move(a));
+		}
+	}
+
+	void null(){
+		if constexpr (is_toml_v<Value>) add(Value("")); // TOML has no null
+		else                            add(Value(nullptr));
+	}
+	void boolean(bool v){ add(Value(v)); }
+	void integer(std::int64_t v){ add(Value(v)); }
+	void uinteger(std::uint64_t v){
+		if constexpr (is_toml_v<Value>) add(Value((double)v)); // beyond TOML's int64
+		else                            add(Value(v));
+	}
+	void floating(double v){ add(Value(v)); }
+	void string(const std::string& v){ add(Value(v)); }
+
+	Value finish(){ return std::move(root_); }
+
+private:
+	struct Frame {
+		explicit Frame(bool is_map) : map(is_map) {}
+
+		bool                                              map;
+		std::string                                       key;
+		std::deque<Value>                                 items;
+		std::deque<std::pair<std::string, Value>>         members;
+		std::unordered_map<std::string_view, std::size_t> index; // views into members, which never move
+	};
+
+	Frame pop(){
+		Frame f = std::move(frames_.back());
+		frames_.pop_back();
+		return f;
+	}
+
+	void add(Value v){
+		if (frames_.empty()) { root_ = std::move(v); return; }
+		auto& f = frames_.back();
+		if (!f.map) { f.items.push_back(std::move(v)); return; }
+		auto it = f.index.find(f.key);
+		if (it != f.index.end()) { f.members[it->second].second = std::move(v); return; }
+		f.members.emplace_back(std::move(f.key), std::move(v));
+		f.index.emplace(f.members.back().first, f.members.size() - 1);
+	}
+
+	std::deque<Frame>  frames_; // deque: a Frame has no noexcept move either
+	Value              root_;
+};
+
+template<class Value>
+ParseBridge yamlTo(){
+	return [](std::string_view in, Document& out, const Options& /*opt*/)->Result{
+		try{
+			DomBuilder<Value> builder;
+			readYamlDocument(in, builder, false);
+			Value v = builder.finish();
+			if constexpr (is_toml_v<Value>) {
+				if (!v.is_table()) return {false, "yaml root is not map"};
+				out.type = Document::Type::Toml;
+			} else {
+				out.type = Document::Type::Json;
+			}
+			out.dom = std::move(v);
+			return {};
+		}catch(const BridgeError& e){
+			return Result{false, e.message};
+		}catch(const std::exception& e){
+			return Result{false, e.what()};
+		}
+	};
+}
+}
+
+static struct _RegisterParseBridges {
+	_RegisterParseBridges(){
+		auto& c = Converter::instance();
+		c.registerParseBridge(Format::Yaml, Format::OrderedJson, yamlTo<nlohmann::ordered_json>());
+		c.registerParseBridge(Format::Yaml, Format::Json,        yamlTo<nlohmann::json>());
+		c.registerParseBridge(Format::Yaml, Format::Toml,        yamlTo<toml::ordered_value>());
+		c.registerParseBridge(Format::Yaml, Format::OrderedToml, yamlTo<toml::value>());
+	}
+} _parse_bridges;
+
+}} // namespace ofx::configbridge
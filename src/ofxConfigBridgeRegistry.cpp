@@ -1,19 +1,17 @@
 #include "ofxConfigBridgeRegistry.hpp"
-#include <string>
+#include <cstring>
 
 namespace ofx { namespace configbridge {
 
 Registry& Registry::instance(){ static Registry r; return r; }
 
 void Registry::registerAdapter(std::unique_ptr<IAdapter> a){
+    const auto i = static_cast<std::size_t>(a->format());
+    if (i < kFormatCount && !by_format_[i]) by_format_[i] = a.get();
     adapters_.push_back(std::move(a));
 }
-IAdapter* Registry::find(Format f){
-    for (auto& a : adapters_) if (a->format()==f) return a.get();
-    return nullptr;
-}
 IAdapter* Registry::findByName(const char* name){
-    for (auto& a : adapters_) if (std::string(a->name())==name) return a.get();
+    for (auto& a : adapters_) if (std::strcmp(a->name(), name)==0) return a.get();
     return nullptr;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "ofxConfigBridgeAdapter.hpp"
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -10,12 +11,17 @@ public:
     static Registry& instance();
 
     void registerAdapter(std::unique_ptr<IAdapter> a);
-    IAdapter* find(Format f);
+    // A single table read; the first adapter registered for a format wins.
+    IAdapter* find(Format f) const {
+        const auto i = static_cast<std::size_t>(f);
+        return i < kFormatCount ? by_format_[i] : nullptr;
+    }
     IAdapter* findByName(const char* name);
 
 private:
     Registry() = default;
     std::vector<std::unique_ptr<IAdapter>> adapters_;
+    std::array<IAdapter*, kFormatCount>    by_format_{}; // filled by registerAdapter
 };
 
 }} // namespace ofx::configbridge
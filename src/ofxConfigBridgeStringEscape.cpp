@@ -0,0 +1,164 @@
+#include "ofxConfigBridgeStringEscape.hpp"
+#include <cstddef>
+
+#if defined(__AVX2__)
+#define OFX_CONFIGBRIDGE_ESCAPE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OFX_CONFIGBRIDGE_ESCAPE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ofx { namespace configbridge {
+
+namespace {
+// 0: copied verbatim, 'u': \u00XX, otherwise the char following the backslash
+constexpr char escapeOf(unsigned char c){
+	return c == '"'  ? '"'
+	     : c == '\\' ? '\\'
+	     : c == '\b' ? 'b'
+	     : c == '\f' ? 'f'
+	     : c == '\n' ? 'n'
+	     : c == '\r' ? 'r'
+	     : c == '\t' ? 't'
+	     : c <  0x20 ? 'u'
+	     : 0;
+}
+struct EscapeTable {
+	char v[256];
+	constexpr EscapeTable() : v() { for (int c = 0; c < 256; ++c) v[c] = escapeOf((unsigned char)c); }
+};
+constexpr EscapeTable kEscape{};
+
+constexpr char kReplacement[] = "\xEF\xBF\xBD";
+
+#if defined(OFX_CONFIGBRIDGE_ESCAPE_AVX2) || defined(OFX_CONFIGBRIDGE_ESCAPE_SSE2)
+inline unsigned lowestBit(unsigned mask){
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return (unsigned)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+// First byte that is a quote, a backslash, a control character, non-ASCII or,
+// when `del` is set, DEL. As signed bytes, controls and non-ASCII are all
+// below ' '.
+const char* findSpecial(const char* p, const char* end, bool del){
+#if defined(OFX_CONFIGBRIDGE_ESCAPE_AVX2)
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i quote = _mm256_set1_epi8('"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	const __m256i extra = _mm256_set1_epi8(del ? '\x7F' : '"');
+	for (; end - p >= 32; p += 32) {
+		const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i hits = _mm256_cmpgt_epi8(space, c);
+		hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(c, quote));
+		hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(c, backslash));
+		hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(c, extra));
+		if (unsigned mask = (unsigned)_mm256_movemask_epi8(hits)) return p + lowestBit(mask);
+	}
+#elif defined(OFX_CONFIGBRIDGE_ESCAPE_SSE2)
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i extra = _mm_set1_epi8(del ? '\x7F' : '"');
+	for (; end - p >= 16; p += 16) {
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i hits = _mm_cmplt_epi8(c, space);
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(c, quote));
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(c, backslash));
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(c, extra));
+		if (unsigned mask = (unsigned)_mm_movemask_epi8(hits)) return p + lowestBit(mask);
+	}
+#endif
+	for (; p != end; ++p) {
+		const unsigned char c = (unsigned char)*p;
+		if (c >= 0x80 || kEscape.v[c] || (del && c == 0x7F)) break;
+	}
+	return p;
+}
+
+// Length of the UTF-8 sequence starting with the non-ASCII byte at p. If it
+// is ill-formed, `valid` is cleared and the length is that of the maximal
+// ill-formed subsequence (at least 1).
+std::size_t utf8Sequence(const char* p, const char* end, bool& valid){
+	const auto* u = reinterpret_cast<const unsigned char*>(p);
+	const std::size_t avail = (std::size_t)(end - p);
+	// the second byte is the one with lead-specific bounds
+	unsigned char lo = 0x80, hi = 0xBF;
+	std::size_t len;
+	if      (u[0] < 0xC2) { valid = false; return 1; }
+	else if (u[0] < 0xE0) len = 2;
+	else if (u[0] < 0xF0) { len = 3; if (u[0] == 0xE0) lo = 0xA0; else if (u[0] == 0xED) hi = 0x9F; }
+	else if (u[0] < 0xF5) { len = 4; if (u[0] == 0xF0) lo = 0x90; else if (u[0] == 0xF4) hi = 0x8F; }
+	else                  { valid = false; return 1; }
+
+	valid = false;
+	if (avail < 2 || u[1] < lo || u[1] > hi) return 1;
+	for (std::size_t n = 2; n < len; ++n)
+		if (n >= avail || (u[n] & 0xC0) != 0x80) return n;
+	valid = true;
+	return len;
+}
+}
+
+void appendQuoted(std::string& out, std::string_view s, StringStyle style){
+	static const char* hex = "0123456789abcdef";
+	const bool del = style == StringStyle::TomlBasic;
+	out.reserve(out.size() + s.size() + 2);
+	out += '"';
+	const char* p = s.data();
+	const char* const end = p + s.size();
+	const char* run = p; // start of the text not yet appended
+	while ((p = findSpecial(p, end, del)) != end) {
+		const unsigned char c = (unsigned char)*p;
+		if (c >= 0x80) {
+			// Well-formed sequences stay in the run. Text mixing scripts stops
+			// the vector scan every few bytes, so stay on bytes until a stretch
+			// of plain ASCII makes the scan worthwhile again.
+			const char* ascii = p;
+			while (p != end && p - ascii < 32) {
+				const unsigned char b = (unsigned char)*p;
+				if (b < 0x80) {
+					if (kEscape.v[b] || (del && b == 0x7F)) break;
+					++p;
+					continue;
+				}
+				bool valid;
+				const std::size_t n = utf8Sequence(p, end, valid);
+				if (!valid) {
+					out.append(run, p);
+					out.append(kReplacement, 3);
+					run = p + n;
+				}
+				p += n;
+				ascii = p;
+			}
+			continue;
+		}
+
+		out.append(run, p);
+		// DEL is only a stop under TOML and is not in the table
+		const char e = kEscape.v[c] ? kEscape.v[c] : 'u';
+		if (e == 'u') {
+			const char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+			out.append(u, 6);
+		} else {
+			const char esc[2] = {'\\', e};
+			out.append(esc, 2);
+		}
+		run = ++p;
+	}
+	out.append(run, end);
+	out += '"';
+}
+
+}} // namespace ofx::configbridge
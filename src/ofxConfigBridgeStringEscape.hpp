@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+namespace ofx { namespace configbridge {
+
+// Quoted string output shared by the JSON and TOML writers.
+//
+// '"', '\\' and control characters are escaped with the short forms both
+// formats share (\b \t \n \f \r) or as \u00XX; TOML basic strings also escape
+// DEL. Ill-formed UTF-8 is replaced by U+FFFD, once per maximal ill-formed
+// subsequence, so the output is always valid UTF-8.
+//
+// Runs that need no escaping are found with SSE2/AVX2 when the build targets
+// them and appended in one piece.
+enum class StringStyle { Json, TomlBasic };
+
+void appendQuoted(std::string& out, std::string_view s, StringStyle style);
+
+}} // namespace ofx::configbridge
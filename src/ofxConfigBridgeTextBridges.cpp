@@ -0,0 +1,294 @@
+#include "ofxConfigBridgeConverter.hpp"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include "ofxConfigBridgeRegistry.hpp"
+#include "ofxConfigBridgeJsonWriter.hpp"
+#include "ofxConfigBridgeTomlWriter.hpp"
+#include "ofxConfigBridgeYamlEvents.hpp"
+#include "yaml.h"
+#include <nlohmann/json.hpp>
+#include "toml.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Text-to-text bridges that convert straight from parser events to output,
+// without building either DOM.
+
+namespace ofx { namespace configbridge {
+
+namespace {
+// A streamed key cannot be merged into its first position. At a repeated key
+// the output starts over from the target DOM, which keeps the last value
+// there, so the result does not depend on which path convertText takes.
+Result startOverFromDom(Format from, Format to, std::string_view in, IOutputSink& out, const Options& opt){
+	if (!out.restart()) return {false, "duplicate key needs an output that can start over"};
+	Document doc;
+	auto r = Converter::instance().parseText(from, to, in, doc, opt);
+	if (!r) return r;
+	return Registry::instance().find(to)->dump(doc, out, opt);
+}
+
+Result yamlToJson(std::string_view in, IOutputSink& out, const Options& opt){
+	try{
+		JsonEventWriter writer(out, opt);
+		readYamlDocument(in, writer, true);
+		writer.flush();
+		if (!out.good()) return Result{false, "write json failed"};
+		return {};
+	}catch(const DuplicateKeyError&){
+		return startOverFromDom(Format::Yaml, Format::OrderedJson, in, out, opt);
+	}catch(const BridgeError& e){
+		return Result{false, e.message};
+	}catch(const std::exception& e){
+		return Result{false, e.what()};
+	}
+}
+
+// Scalar text JsonToYAMLNode and TomlValueToYaml give a float: finite values
+// keep a '.' or exponent so they stay floats in YAML.
+void appendYamlFloat(std::string& out, double v){
+	if (std::isnan(v))      out += ".nan";
+	else if (std::isinf(v)) out += v < 0 ? "-.inf" : ".inf";
+	else                    appendFloat(out, v, -1);
+}
+
+template<class Int>
+void appendInt(std::string& out, Int v){
+	char buf[24];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v);
+	out.append(buf, r.ptr);
+}
+
+// Emits nlohmann SAX events through YAML::Emitter as JsonToYAMLNode and
+// `emitter << node` would: numbers and booleans become plain scalars, finite
+// floats keep a '.' or exponent, and the emitter applies
+// Options::float_precision as each one is written. Object keys stay in
+// document order, so a repeated key throws DuplicateKeyError.
+class JsonToYamlEvents {
+public:
+	explicit JsonToYamlEvents(YAML::Emitter& out) : out_(out) {}
+
+	bool null(){ beginNode(); out_ << YAML::Null; return true; }
+	bool boolean(bool v){ beginNode(); out_ << (v ? "true" : "false"); return true; }
+	bool number_integer(std::int64_t v){ return integer(v); }
+	bool number_unsigned(std::uint64_t v){ return integer(v); }
+	bool number_float(double v, const std::string&){
+		beginNode();
+		scratch_.clear();
+		appendYamlFloat(scratch_, v);
+		out_ << scratch_;
+		return true;
+	}
+	bool string(std::string& s){ beginNode(); out_ << s; return true; }
+	bool binary(nlohmann::json::binary_t&){ throw BridgeError{"binary values are not supported"}; }
+
+	bool start_object(std::size_t){
+		beginNode();
+		out_ << YAML::BeginMap;
+		stack_.push_back({true, {}});
+		return true;
+	}
+	bool key(std::string& k){
+		auto& map = stack_.back();
+		if (!map.keys.insert(k).second) throw DuplicateKeyError{};
+		out_ << YAML::Key << k;
+		return true;
+	}
+	bool end_object(){ out_ << YAML::EndMap; stack_.pop_back(); return true; }
+	bool start_array(std::size_t){
+		beginNode();
+		out_ << YAML::BeginSeq;
+		stack_.push_back({false, {}});
+		return true;
+	}
+	bool end_array(){ out_ << YAML::EndSeq; stack_.pop_back(); return true; }
+
+	bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e){ throw e; }
+
+private:
+	struct Container {
+		bool                            map;
+		std::unordered_set<std::string> keys;
+	};
+
+	// a value inside a map follows its key
+	void beginNode(){
+		if (stack_.empty() || !stack_.back().map) return;
+		out_ << YAML::Value;
+	}
+
+	template<class Int>
+	bool integer(Int v){
+		beginNode();
+		scratch_.clear();
+		appendInt(scratch_, v);
+		out_ << scratch_;
+		return true;
+	}
+
+	YAML::Emitter&         out_;
+	std::vector<Container> stack_;
+	std::string            scratch_;
+};
+
+Result jsonToYaml(std::string_view in, IOutputSink& out, const Options& opt){
+	try{
+		SinkStreamBuf buffer(out);
+		std::ostream stream(&buffer);
+		YAML::Emitter emitter(stream);
+		setYamlFloatPrecision(emitter, opt.float_precision);
+		JsonToYamlEvents events(emitter);
+		nlohmann::ordered_json::sax_parse(in.data(), in.data() + in.size(), &events);
+		if (!emitter.good()) return Result{false, "yaml emitter error"};
+		if (buffer.pubsync() != 0) return Result{false, "write yaml failed"};
+		return {};
+	}catch(const DuplicateKeyError&){
+		return startOverFromDom(Format::OrderedJson, Format::Yaml, in, out, opt);
+	}catch(const BridgeError& e){
+		return Result{false, e.message};
+	}catch(const std::exception& e){
+		return Result{false, e.what()};
+	}
+}
+
+template<class TomlValue>
+auto sortedMembers(const TomlValue& table){
+	using Member = typename TomlValue::table_type::value_type;
+	const auto& t = table.as_table();
+	std::vector<const Member*> members;
+	members.reserve(t.size());
+	for (const auto& kv : t) members.push_back(&kv);
+	std::sort(members.begin(), members.end(), [](const Member* a, const Member* b){ return a->first < b->first; });
+	return members;
+}
+
+// Writes a TOML value as TomlValueToJson and JsonWriter would, in one walk.
+template<class TomlValue>
+void writeTomlAsJson(JsonEventWriter& out, const TomlValue& v, bool sort_keys, std::string& scratch){
+	if (v.is_string())        out.string(v.as_string());
+	else if (v.is_integer())  out.integer(v.as_integer());
+	else if (v.is_floating()) out.floating(v.as_floating());
+	else if (v.is_boolean())  out.boolean(v.as_boolean());
+	else if (v.is_array()) {
+		out.beginArray();
+		for (const auto& el : v.as_array()) writeTomlAsJson(out, el, sort_keys, scratch);
+		out.endArray();
+	}
+	else if (v.is_table()) {
+		out.beginObject();
+		if (sort_keys) {
+			for (const auto* m : sortedMembers(v)) {
+				out.key(m->first);
+				writeTomlAsJson(out, m->second, sort_keys, scratch);
+			}
+		} else {
+			for (const auto& kv : v.as_table()) {
+				out.key(kv.first);
+				writeTomlAsJson(out, kv.second, sort_keys, scratch);
+			}
+		}
+		out.endObject();
+	}
+	else if (v.is_local_date() || v.is_local_time()
+		  || v.is_local_datetime() || v.is_offset_datetime()) {
+		scratch.clear();
+		appendTomlDateTime(scratch, v);
+		out.string(scratch);
+	}
+	else out.null();
+}
+
+// Emits a TOML value as TomlValueToYaml and `emitter << node` would, in one walk.
+template<class TomlValue>
+void emitTomlAsYaml(YAML::Emitter& out, const TomlValue& v, std::string& scratch){
+	if (v.is_string())        out << v.as_string();
+	else if (v.is_integer())  { scratch.clear(); appendInt(scratch, v.as_integer()); out << scratch; }
+	else if (v.is_floating()) { scratch.clear(); appendYamlFloat(scratch, v.as_floating()); out << scratch; }
+	else if (v.is_boolean())  out << (v.as_boolean() ? "true" : "false");
+	else if (v.is_array()) {
+		out << YAML::BeginSeq;
+		for (const auto& el : v.as_array()) emitTomlAsYaml(out, el, scratch);
+		out << YAML::EndSeq;
+	}
+	else if (v.is_table()) {
+		out << YAML::BeginMap;
+		for (const auto& kv : v.as_table()) {
+			out << YAML::Key << kv.first << YAML::Value;
+			emitTomlAsYaml(out, kv.second, scratch);
+		}
+		out << YAML::EndMap;
+	}
+	else if (v.is_local_date() || v.is_local_time()
+		  || v.is_local_datetime() || v.is_offset_datetime()) {
+		scratch.clear();
+		appendTomlDateTime(scratch, v);
+		out << scratch;
+	}
+	else out << YAML::Null;
+}
+
+// toml11 has no event interface, so the source is parsed with the adapter for
+// `from`, which keeps its table ordering; only the target DOM is skipped.
+template<class F>
+Result withParsedToml(Format from, std::string_view in, F&& f){
+	auto* adapter = Registry::instance().find(from);
+	if (!adapter) return {false, "no adapter for bridge"};
+	Document doc;
+	auto r = adapter->parseText(in, doc);
+	if (!r) return r;
+	if (auto* v = doc.get_if<Document::UTomlDom>()) return f(*v);
+	return f(doc.toml());
+}
+
+// Unordered JSON output sorts keys, which the walk does per table.
+TextBridge tomlToJson(Format from, bool sort_keys){
+	return [from, sort_keys](std::string_view in, IOutputSink& out, const Options& opt)->Result{
+		return withParsedToml(from, in, [&](const auto& v)->Result{
+			JsonEventWriter writer(out, opt);
+			std::string scratch;
+			writeTomlAsJson(writer, v, sort_keys, scratch);
+			writer.flush();
+			if (!out.good()) return Result{false, "write json failed"};
+			return {};
+		});
+	};
+}
+
+TextBridge tomlToYaml(Format from){
+	return [from](std::string_view in, IOutputSink& out, const Options& opt)->Result{
+		return withParsedToml(from, in, [&](const auto& v)->Result{
+			SinkStreamBuf buffer(out);
+			std::ostream stream(&buffer);
+			YAML::Emitter emitter(stream);
+			setYamlFloatPrecision(emitter, opt.float_precision);
+			std::string scratch;
+			emitTomlAsYaml(emitter, v, scratch);
+			if (!emitter.good()) return Result{false, "yaml emitter error"};
+			if (buffer.pubsync() != 0) return Result{false, "write yaml failed"};
+			return {};
+		});
+	};
+}
+}
+
+static struct _RegisterTextBridges {
+	_RegisterTextBridges(){
+		auto& c = Converter::instance();
+		// Unordered JSON keeps its keys sorted, which needs whole maps; from YAML
+		// and to or from JSON it takes the DOM path.
+		c.registerTextBridge(Format::Yaml, Format::OrderedJson, yamlToJson);
+		c.registerTextBridge(Format::OrderedJson, Format::Yaml, jsonToYaml);
+		for (Format from : {Format::Toml, Format::OrderedToml}) {
+			c.registerTextBridge(from, Format::OrderedJson, tomlToJson(from, false));
+			c.registerTextBridge(from, Format::Json,        tomlToJson(from, true));
+			c.registerTextBridge(from, Format::Yaml,        tomlToYaml(from));
+		}
+	}
+} _text_bridges;
+
+}} // namespace ofx::configbridge
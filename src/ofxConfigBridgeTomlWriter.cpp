@@ -0,0 +1,250 @@
+#include "ofxConfigBridgeTomlWriter.hpp"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include "ofxConfigBridgeOutputSink.hpp"
+#include "ofxConfigBridgeStringEscape.hpp"
+#include "toml.hpp"
+#include <algorithm>
+#include <charconv>
+#include <type_traits>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+namespace {
+bool isBareKey(std::string_view key){
+	if (key.empty()) return false;
+	for (char c : key) {
+		const bool bare = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+		if (!bare) return false;
+	}
+	return true;
+}
+
+void appendKey(std::string& out, std::string_view key){
+	if (isBareKey(key)) out.append(key.data(), key.size());
+	else appendQuoted(out, key, StringStyle::TomlBasic);
+}
+
+// Zero-padded to `width` digits, as toml11 writes with setw/setfill
+void appendPadded(std::string& out, int v, int width){
+	char buf[12];
+	auto r = std::to_chars(buf, buf + sizeof(buf), v);
+	for (int n = (int)(r.ptr - buf); n < width; ++n) out += '0';
+	out.append(buf, r.ptr);
+}
+
+void appendDate(std::string& out, const toml::local_date& d){
+	appendPadded(out, d.year, 4);
+	out += '-';
+	appendPadded(out, d.month + 1, 2); // stored 0-based
+	out += '-';
+	appendPadded(out, d.day, 2);
+}
+
+void appendTime(std::string& out, const toml::local_time& t, bool has_seconds, std::size_t subsecond_precision){
+	appendPadded(out, t.hour, 2);
+	out += ':';
+	appendPadded(out, t.minute, 2);
+	if (!has_seconds) return;
+	out += ':';
+	appendPadded(out, t.second, 2);
+	if (subsecond_precision == 0) return;
+	std::string digits;
+	appendPadded(digits, t.millisecond, 3);
+	appendPadded(digits, t.microsecond, 3);
+	appendPadded(digits, t.nanosecond, 3);
+	out += '.';
+	out.append(digits, 0, std::min<std::size_t>(subsecond_precision, digits.size()));
+}
+
+void appendDelimiter(std::string& out, toml::datetime_delimiter_kind d){
+	switch (d) {
+	case toml::datetime_delimiter_kind::lower_t: out += 't'; break;
+	case toml::datetime_delimiter_kind::space:   out += ' '; break;
+	default:                                     out += 'T'; break;
+	}
+}
+
+void appendOffset(std::string& out, const toml::time_offset& o){
+	if (o.hour == 0 && o.minute == 0) { out += 'Z'; return; }
+	int minutes = o.hour * 60 + o.minute;
+	out += minutes < 0 ? '-' : '+';
+	if (minutes < 0) minutes = -minutes;
+	appendPadded(out, minutes / 60, 2);
+	out += ':';
+	appendPadded(out, minutes % 60, 2);
+}
+
+// Plain keys are the members written as `key = value` lines. Tables and
+// arrays of tables become sections and follow them.
+template<class TomlValue>
+bool isSection(const TomlValue& v){
+	return v.is_table() || v.is_array_of_tables();
+}
+
+// Members in output order. unordered_map iteration order is unspecified, so
+// unordered tables are sorted to keep the output stable.
+template<class TomlValue>
+auto membersOf(const TomlValue& table){
+	using Member = typename TomlValue::table_type::value_type;
+	const auto& t = table.as_table();
+	std::vector<const Member*> members;
+	members.reserve(t.size());
+	for (const auto& kv : t) members.push_back(&kv);
+	if constexpr (std::is_same_v<TomlValue, toml::value>)
+		std::sort(members.begin(), members.end(), [](const Member* a, const Member* b){ return a->first < b->first; });
+	return members;
+}
+}
+
+template<class TomlValue>
+void appendTomlDateTime(std::string& out, const TomlValue& v){
+	switch (v.type()) {
+	case toml::value_t::local_date:
+		appendDate(out, v.as_local_date());
+		break;
+	case toml::value_t::local_time: {
+		const auto& fmt = v.as_local_time_fmt();
+		appendTime(out, v.as_local_time(), fmt.has_seconds, fmt.subsecond_precision);
+		break;
+	}
+	case toml::value_t::local_datetime: {
+		const auto& dt = v.as_local_datetime();
+		const auto& fmt = v.as_local_datetime_fmt();
+		appendDate(out, dt.date);
+		appendDelimiter(out, fmt.delimiter);
+		appendTime(out, dt.time, fmt.has_seconds, fmt.subsecond_precision);
+		break;
+	}
+	case toml::value_t::offset_datetime: {
+		const auto& dt = v.as_offset_datetime();
+		const auto& fmt = v.as_offset_datetime_fmt();
+		appendDate(out, dt.date);
+		appendDelimiter(out, fmt.delimiter);
+		appendTime(out, dt.time, fmt.has_seconds, fmt.subsecond_precision);
+		appendOffset(out, dt.offset);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+template<class TomlValue>
+void TomlWriter::write(const TomlValue& v){
+	if (out_.capacity() - out_.size() < 4096) out_.reserve(out_.size() + 4096);
+	empty_ = true;
+	path_.clear();
+	if (v.is_table()) writeTable(v);
+	else writeInline(v);
+	if (sink_) flushToSink();
+}
+
+void TomlWriter::flushToSink(){
+	sink_->write(out_);
+	out_.clear();
+}
+
+void TomlWriter::writeHeader(bool array_of_tables){
+	if (!empty_) out_ += '\n';
+	empty_ = false;
+	out_ += array_of_tables ? "[[" : "[";
+	out_ += path_;
+	out_ += array_of_tables ? "]]\n" : "]\n";
+}
+
+template<class TomlValue>
+void TomlWriter::writeTable(const TomlValue& table){
+	const auto members = membersOf(table);
+	for (const auto* m : members) {
+		if (isSection(m->second)) continue;
+		appendKey(out_, m->first);
+		out_ += " = ";
+		writeInline(m->second);
+		out_ += '\n';
+		empty_ = false;
+		spill();
+	}
+
+	const std::size_t parent = path_.size();
+	for (const auto* m : members) {
+		const TomlValue& v = m->second;
+		if (!isSection(v)) continue;
+		if (parent != 0) path_ += '.';
+		appendKey(path_, m->first);
+		if (v.is_table()) {
+			// a table holding only sections is implied by their headers
+			const auto& sub = v.as_table();
+			const bool implied = !sub.empty() && std::all_of(sub.begin(), sub.end(), [](const auto& kv){ return isSection(kv.second); });
+			if (!implied) writeHeader(false);
+			writeTable(v);
+		} else {
+			for (const auto& element : v.as_array()) {
+				writeHeader(true);
+				writeTable(element);
+			}
+		}
+		path_.resize(parent);
+	}
+}
+
+template<class TomlValue>
+void TomlWriter::writeInline(const TomlValue& v){
+	switch (v.type()) {
+	case toml::value_t::boolean:
+		out_ += v.as_boolean() ? "true" : "false";
+		break;
+	case toml::value_t::integer: {
+		char buf[24];
+		auto r = std::to_chars(buf, buf + sizeof(buf), v.as_integer());
+		out_.append(buf, r.ptr);
+		break;
+	}
+	case toml::value_t::floating:
+		appendFloat(out_, v.as_floating(), precision_);
+		break;
+	case toml::value_t::string:
+		appendQuoted(out_, v.as_string(), StringStyle::TomlBasic);
+		break;
+	case toml::value_t::array: {
+		out_ += '[';
+		bool first = true;
+		for (const auto& e : v.as_array()) {
+			if (!first) out_ += ", ";
+			first = false;
+			writeInline(e);
+			spill();
+		}
+		out_ += ']';
+		break;
+	}
+	case toml::value_t::table: {
+		if (v.as_table().empty()) { out_ += "{}"; break; }
+		out_ += "{ ";
+		bool first = true;
+		for (const auto* m : membersOf(v)) {
+			if (!first) out_ += ", ";
+			first = false;
+			appendKey(out_, m->first);
+			out_ += " = ";
+			writeInline(m->second);
+		}
+		out_ += " }";
+		break;
+	}
+	case toml::value_t::empty:
+		// TOML has no null; match the converters, which map it to ""
+		out_ += "\"\"";
+		break;
+	default:
+		appendTomlDateTime(out_, v);
+		break;
+	}
+}
+
+template void TomlWriter::write(const toml::value&);
+template void TomlWriter::write(const toml::ordered_value&);
+template void appendTomlDateTime(std::string&, const toml::value&);
+template void appendTomlDateTime(std::string&, const toml::ordered_value&);
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,48 @@
+#pragma once
+#include "ofxConfigBridgeFormat.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ofx { namespace configbridge {
+
+class IOutputSink;
+
+// Serialises toml11 values in a single pass by appending to a caller-owned
+// string, like JsonWriter.
+// Sub-tables become [dotted.path] sections and arrays whose elements are all
+// tables become [[array.of.tables]]; tables inside inline arrays are written
+// as inline tables. Each table lists its plain keys before its sub-tables,
+// as TOML requires. Unordered tables are written with sorted keys.
+// Floats follow Options::float_precision (see ofxConfigBridgeFloatFormat.hpp).
+// With a sink, `out` only stages text between chunks, as in JsonWriter.
+class TomlWriter {
+public:
+    static constexpr std::size_t kSpillSize = 64 * 1024;
+
+    TomlWriter(std::string& out, const Options& opt, IOutputSink* sink = nullptr)
+    : out_(out), sink_(sink), precision_(opt.float_precision) {}
+
+    // Supported for toml::value and toml::ordered_value. A root that is not a
+    // table is written as a bare value.
+    template<class TomlValue> void write(const TomlValue& v);
+
+private:
+    template<class TomlValue> void writeTable(const TomlValue& table);
+    template<class TomlValue> void writeInline(const TomlValue& v);
+    void writeHeader(bool array_of_tables);
+    void spill(){ if (sink_ && out_.size() >= kSpillSize) flushToSink(); }
+    void flushToSink();
+
+    std::string& out_;
+    IOutputSink* sink_;
+    std::string  path_; // keys of the current section, quoted where needed, joined by '.'
+    int          precision_;
+    bool         empty_ = true; // nothing written yet, so no blank line before the first header
+};
+
+// Appends a date, time or datetime value as toml::format would write it.
+// Supported for toml::value and toml::ordered_value.
+template<class TomlValue> void appendTomlDateTime(std::string& out, const TomlValue& v);
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,188 @@
+#pragma once
+#include "ofxConfigBridgeYamlScalar.hpp"
+#include "yaml.h"
+#include "yaml-cpp/eventhandler.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace ofx { namespace configbridge {
+
+// Thrown from event handlers to abandon a conversion; the message is static.
+struct BridgeError { const char* message; };
+
+// Thrown by streaming conversions at a key that its map already has.
+struct DuplicateKeyError {};
+
+// One yaml-cpp parser event, kept so anchored nodes can be replayed.
+struct YamlEvent {
+    enum class Type : unsigned char { Null, Scalar, SequenceStart, SequenceEnd, MapStart, MapEnd };
+    Type        type;
+    std::string tag;
+    std::string value;
+};
+
+// Turns YAML parser events into calls on `Output` with the results of
+// YAMLNodeToJson: scalars resolve by tag and the core schema, a key is its
+// scalar text ("null" for a null key, "" for a map or sequence used as a
+// key), and aliases repeat the anchored node.
+//
+// Output provides beginObject/endObject/beginArray/endArray, key(k) before
+// each member value, and null/boolean/integer/uinteger/floating/string.
+//
+// Only anchored nodes are kept in memory, as their events, to be replayed at
+// each alias. With unique_keys a repeated key in one map throws
+// DuplicateKeyError, for outputs that cannot merge it into its first position.
+template<class Output>
+class YamlEvents final : public YAML::EventHandler {
+public:
+    YamlEvents(Output& out, bool unique_keys) : out_(out), unique_keys_(unique_keys) {}
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override {
+        begin(anchor);
+        process({YamlEvent::Type::Null, {}, {}});
+    }
+    void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) override {
+        if (anchor >= anchors_.size() || !anchors_[anchor].complete) throw BridgeError{"yaml alias refers to an unfinished anchor"};
+        // replayed events are recorded into enclosing anchors but start none
+        for (const auto& e : anchors_[anchor].events) process(e);
+    }
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override {
+        begin(anchor);
+        process({YamlEvent::Type::Scalar, tag, value});
+    }
+    void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        begin(anchor);
+        process({YamlEvent::Type::SequenceStart, {}, {}});
+    }
+    void OnSequenceEnd() override { process({YamlEvent::Type::SequenceEnd, {}, {}}); }
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        begin(anchor);
+        process({YamlEvent::Type::MapStart, {}, {}});
+    }
+    void OnMapEnd() override { process({YamlEvent::Type::MapEnd, {}, {}}); }
+
+private:
+    struct Anchor {
+        std::vector<YamlEvent> events;
+        std::size_t            depth = 0; // nesting depth the node started at
+        bool                   complete = false;
+    };
+    struct Container {
+        bool                            map;
+        bool                            expect_key;
+        std::unordered_set<std::string> keys; // only with unique_keys
+    };
+
+    // Starts recording the node that the next event opens.
+    void begin(YAML::anchor_t anchor){
+        if (anchor == YAML::NullAnchor) return;
+        if (anchor >= anchors_.size()) anchors_.resize(anchor + 1);
+        anchors_[anchor] = Anchor{{}, depth_, false};
+        recording_.push_back(anchor);
+    }
+
+    void process(const YamlEvent& e){
+        const bool opens  = e.type == YamlEvent::Type::SequenceStart || e.type == YamlEvent::Type::MapStart;
+        const bool closes = e.type == YamlEvent::Type::SequenceEnd || e.type == YamlEvent::Type::MapEnd;
+        if (closes) --depth_;
+        for (auto a : recording_) anchors_[a].events.push_back(e);
+        // a recording ends with the node it started with
+        while (!recording_.empty() && anchors_[recording_.back()].depth == depth_ && !opens) {
+            anchors_[recording_.back()].complete = true;
+            recording_.pop_back();
+        }
+        if (opens) ++depth_;
+
+        if (skip_depth_ > 0) {
+            // inside a map or sequence used as a key
+            if (opens) ++skip_depth_;
+            else if (closes && --skip_depth_ == 0) key("");
+            return;
+        }
+        if (!stack_.empty() && stack_.back().map && stack_.back().expect_key) {
+            switch (e.type) {
+                case YamlEvent::Type::Null:   key("null"); return;
+                case YamlEvent::Type::Scalar: key(e.value); return;
+                case YamlEvent::Type::MapEnd: close(); return;
+                default:                      skip_depth_ = 1; return;
+            }
+        }
+        switch (e.type) {
+            case YamlEvent::Type::Null:
+                out_.null();
+                valueDone();
+                break;
+            case YamlEvent::Type::Scalar:
+                scalar(e.tag, e.value);
+                valueDone();
+                break;
+            case YamlEvent::Type::SequenceStart:
+                out_.beginArray();
+                stack_.push_back({false, false, {}});
+                break;
+            case YamlEvent::Type::MapStart:
+                out_.beginObject();
+                stack_.push_back({true, true, {}});
+                break;
+            case YamlEvent::Type::SequenceEnd:
+            case YamlEvent::Type::MapEnd:
+                close();
+                break;
+        }
+    }
+
+    void key(const std::string& k){
+        auto& map = stack_.back();
+        if (unique_keys_ && !map.keys.insert(k).second) throw DuplicateKeyError{};
+        out_.key(k);
+        map.expect_key = false;
+    }
+
+    void close(){
+        if (stack_.back().map) out_.endObject();
+        else                   out_.endArray();
+        stack_.pop_back();
+        valueDone();
+    }
+
+    void valueDone(){
+        if (!stack_.empty() && stack_.back().map) stack_.back().expect_key = true;
+    }
+
+    void scalar(const std::string& tag, const std::string& value){
+        const auto r = resolveYamlScalar(tag, value);
+        switch (r.kind) {
+            case YamlScalar::Kind::Null:  out_.null(); break;
+            case YamlScalar::Kind::Bool:  out_.boolean(r.b); break;
+            case YamlScalar::Kind::Int:   out_.integer(r.i); break;
+            case YamlScalar::Kind::Uint:  out_.uinteger(r.u); break;
+            case YamlScalar::Kind::Float: out_.floating(r.f); break;
+            default:                      out_.string(value); break;
+        }
+    }
+
+    Output&                     out_;
+    bool                        unique_keys_;
+    std::vector<Container>      stack_;
+    std::vector<Anchor>         anchors_;   // indexed by anchor id
+    std::vector<YAML::anchor_t> recording_; // anchors whose node is still open
+    std::size_t                 depth_ = 0;
+    std::size_t                 skip_depth_ = 0;
+};
+
+// Reads the first document, as YAML::Load does; no document gives null.
+// Throws BridgeError, DuplicateKeyError or YAML::Exception.
+template<class Output>
+void readYamlDocument(std::string_view in, Output& out, bool unique_keys){
+    YamlEvents<Output> events(out, unique_keys);
+    YAML::Parser parser(in.data(), in.size());
+    if (!parser.HandleNextDocument(events)) out.null();
+}
+
+}} // namespace ofx::configbridge
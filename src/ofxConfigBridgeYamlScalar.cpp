@@ -0,0 +1,201 @@
+#include "ofxConfigBridgeYamlScalar.hpp"
+#include "ofxConfigBridgeFloatFormat.hpp"
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#endif
+
+namespace ofx { namespace configbridge {
+
+namespace {
+// What the first byte of a plain scalar can start.
+enum Lead : unsigned char { Str, Digit, Sign, Dot, NullLead, TrueLead, FalseLead };
+
+struct LeadTable {
+	Lead v[256];
+	constexpr LeadTable() : v() {
+		for (int c = 0; c < 256; ++c) v[c] = Str;
+		for (int c = '0'; c <= '9'; ++c) v[c] = Digit;
+		v['-'] = v['+'] = Sign;
+		v['.'] = Dot;
+		v['n'] = v['N'] = v['~'] = NullLead;
+		v['t'] = v['T'] = TrueLead;
+		v['f'] = v['F'] = FalseLead;
+	}
+};
+constexpr LeadTable kLead{};
+
+bool isDigit(char c){ return c >= '0' && c <= '9'; }
+
+bool oneOf(std::string_view s, std::string_view a, std::string_view b, std::string_view c){
+	return s == a || s == b || s == c;
+}
+
+YamlScalar make(YamlScalar::Kind k){ YamlScalar r; r.kind = k; return r; }
+
+YamlScalar makeFloat(double f){ YamlScalar r; r.kind = YamlScalar::Kind::Float; r.f = f; return r; }
+
+// Reads a decimal float as std::from_chars does: on overflow or underflow to
+// zero the result is result_out_of_range and `value` is left alone.
+std::errc parseFloat(const char* first, const char* last, double& value){
+#if defined(__cpp_lib_to_chars)
+	return std::from_chars(first, last, value).ec;
+#else
+	// no floating-point from_chars (e.g. Apple's libc++): strtod in the C
+	// locale, on a terminated copy
+	char small[64];
+	std::string large;
+	const std::size_t n = (std::size_t)(last - first);
+	char* text = small;
+	if (n >= sizeof(small)) { large.assign(first, last); text = &large[0]; }
+	else                    { std::memcpy(small, first, n); small[n] = '\0'; }
+#if defined(_WIN32)
+	static const _locale_t c_locale = _create_locale(LC_ALL, "C");
+	errno = 0;
+	const double d = _strtod_l(text, nullptr, c_locale);
+#else
+	static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	errno = 0;
+	const double d = strtod_l(text, nullptr, c_locale);
+#endif
+	if (errno == ERANGE && (d == 0 || std::isinf(d))) return std::errc::result_out_of_range;
+	value = d;
+	return std::errc();
+#endif
+}
+
+// [-+]?[0-9]+ | 0o[0-7]+ | 0x[0-9a-fA-F]+ | float, s non-empty and starting with a digit, sign or '.'
+YamlScalar resolveNumber(std::string_view s){
+	const char* first = s.data();
+	const char* last = first + s.size();
+	const char* p = first;
+	bool negative = false;
+	if (*p == '-' || *p == '+') { negative = *p == '-'; ++p; }
+	const char* digits = p;
+
+	if (!negative && p == first && last - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'o')) {
+		const int base = p[1] == 'x' ? 16 : 8;
+		std::uint64_t u = 0;
+		auto r = std::from_chars(p + 2, last, u, base);
+		if (r.ptr != last || r.ec != std::errc()) return make(YamlScalar::Kind::String);
+		YamlScalar out;
+		if (u <= (std::uint64_t)std::numeric_limits<std::int64_t>::max()) { out.kind = YamlScalar::Kind::Int; out.i = (std::int64_t)u; }
+		else                                                               { out.kind = YamlScalar::Kind::Uint; out.u = u; }
+		return out;
+	}
+
+	// single pass over the shape, deciding int vs float
+	std::size_t mantissa = 0;
+	bool isFloat = false;
+	for (; p != last && isDigit(*p); ++p) ++mantissa;
+	if (p != last && *p == '.') {
+		isFloat = true;
+		for (++p; p != last && isDigit(*p); ++p) ++mantissa;
+	}
+	if (mantissa == 0) {
+		// .inf / -.inf / .nan
+		std::string_view rest(digits, last - digits);
+		if (oneOf(rest, ".inf", ".Inf", ".INF"))
+			return makeFloat(negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity());
+		if (digits == first && oneOf(rest, ".nan", ".NaN", ".NAN"))
+			return makeFloat(std::numeric_limits<double>::quiet_NaN());
+		return make(YamlScalar::Kind::String);
+	}
+	if (p != last && (*p == 'e' || *p == 'E')) {
+		isFloat = true;
+		++p;
+		if (p != last && (*p == '-' || *p == '+')) ++p;
+		if (p == last || !isDigit(*p)) return make(YamlScalar::Kind::String);
+		while (p != last && isDigit(*p)) ++p;
+	}
+	if (p != last) return make(YamlScalar::Kind::String);
+
+	const char* number = *first == '+' ? first + 1 : first;
+	if (!isFloat) {
+		YamlScalar out;
+		std::int64_t i = 0;
+		if (std::from_chars(number, last, i).ec == std::errc()) {
+			out.kind = YamlScalar::Kind::Int; out.i = i;
+			return out;
+		}
+		std::uint64_t u = 0;
+		if (!negative && std::from_chars(digits, last, u).ec == std::errc()) {
+			out.kind = YamlScalar::Kind::Uint; out.u = u;
+			return out;
+		}
+		// out of range: fall through to a float
+	}
+	double f = 0;
+	const auto ec = parseFloat(number, last, f);
+	if (ec != std::errc() && ec != std::errc::result_out_of_range) return make(YamlScalar::Kind::String);
+	return makeFloat(f);
+}
+}
+
+YamlScalar resolveYamlScalar(std::string_view s){
+	if (s.empty()) return make(YamlScalar::Kind::Null);
+	switch (kLead.v[(unsigned char)s[0]]) {
+		case Str:
+			return make(YamlScalar::Kind::String);
+		case NullLead:
+			if (s == "~" || oneOf(s, "null", "Null", "NULL")) return make(YamlScalar::Kind::Null);
+			return make(YamlScalar::Kind::String);
+		case TrueLead:
+			if (oneOf(s, "true", "True", "TRUE")) { YamlScalar r = make(YamlScalar::Kind::Bool); r.b = true; return r; }
+			return make(YamlScalar::Kind::String);
+		case FalseLead:
+			if (oneOf(s, "false", "False", "FALSE")) return make(YamlScalar::Kind::Bool);
+			return make(YamlScalar::Kind::String);
+		default:
+			return resolveNumber(s);
+	}
+}
+
+YamlScalar resolveYamlScalar(std::string_view tag, std::string_view s){
+	if (tag.empty() || tag == "?") return resolveYamlScalar(s);
+	if (tag == "!") return make(YamlScalar::Kind::String); // quoted
+
+	std::string_view t(tag);
+	constexpr std::string_view kCore = "tag:yaml.org,2002:";
+	if (t.substr(0, kCore.size()) == kCore) t = t.substr(kCore.size());
+	else if (t.substr(0, 2) == "!!")        t = t.substr(2);
+	else                                    return make(YamlScalar::Kind::String);
+
+	YamlScalar r = resolveYamlScalar(s);
+	const bool matches =
+		(t == "null"  && r.kind == YamlScalar::Kind::Null) ||
+		(t == "bool"  && r.kind == YamlScalar::Kind::Bool) ||
+		(t == "int"   && (r.kind == YamlScalar::Kind::Int || r.kind == YamlScalar::Kind::Uint)) ||
+		(t == "float" && r.kind == YamlScalar::Kind::Float);
+	if (matches) return r;
+	if (t == "float" && (r.kind == YamlScalar::Kind::Int || r.kind == YamlScalar::Kind::Uint))
+		return makeFloat(r.kind == YamlScalar::Kind::Int ? (double)r.i : (double)r.u);
+	return make(YamlScalar::Kind::String);
+}
+
+YamlScalar resolveYamlScalar(const YAML::Node& n){
+	if (!n.IsDefined() || n.IsNull()) return make(YamlScalar::Kind::Null);
+	if (!n.IsScalar()) return make(YamlScalar::Kind::String);
+	return resolveYamlScalar(n.Tag(), n.Scalar());
+}
+
+void setYamlFloatPrecision(YAML::Emitter& emitter, int precision){
+	emitter.SetScalarFormatter([precision](const std::string& s, std::string& out){
+		const auto r = resolveYamlScalar(s);
+		if (r.kind != YamlScalar::Kind::Float || !std::isfinite(r.f)) return false;
+		appendFloat(out, r.f, precision);
+		return true;
+	});
+}
+
+}} // namespace ofx::configbridge
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "yaml.h"
+
+namespace ofx { namespace configbridge {
+
+// Result of resolving a YAML scalar against the YAML 1.2 core schema.
+struct YamlScalar {
+    enum class Kind { Null, Bool, Int, Uint, Float, String };
+
+    Kind          kind = Kind::String;
+    bool          b = false;
+    std::int64_t  i = 0;
+    std::uint64_t u = 0; // only for integers above INT64_MAX
+    double        f = 0;
+};
+
+// Resolves a plain (untagged, unquoted) scalar. Never throws.
+YamlScalar resolveYamlScalar(std::string_view s);
+
+// Resolves a scalar with the tag the parser reported for it, honouring quoting
+// and explicit tags: quoted scalars ("!") and !!str stay strings, other
+// explicit core tags force their kind.
+YamlScalar resolveYamlScalar(std::string_view tag, std::string_view s);
+
+// Same for a scalar node; null and undefined nodes resolve to Null.
+YamlScalar resolveYamlScalar(const YAML::Node& n);
+
+// Makes `emitter` rewrite untagged plain float values with formatFloat at
+// `precision`, as the JSON and TOML writers do. Map keys, quoted or tagged
+// scalars and .inf/.nan are written as they are.
+void setYamlFloatPrecision(YAML::Emitter& emitter, int precision);
+
+}} // namespace ofx::configbridge